@@ -0,0 +1,77 @@
+#include "batch_budget.h"
+#include "benchmark_manifest.h"
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static bool readInstanceWeight(const string &instancePath, double &weight) {
+    // Cabeçalho: "n_jobs n_stages" e, na linha seguinte, as máquinas de cada estágio
+    ifstream file(instancePath);
+    int jobs = 0, stages = 0, machines = 0;
+    if (!(file >> jobs >> stages)) return false;
+    for (int s = 0; s < stages; s++) {
+        int count;
+        if (!(file >> count)) return false;
+        machines += count;
+    }
+    weight = (double) jobs * stages * machines;
+    return weight > 0.0;
+}
+
+vector<double> instanceWeights(const string &manifestPath, const string &instancesDir,
+                               const vector<string> &instanceFiles) {
+    map<string, double> manifestWeights;
+    for (const ManifestEntry &entry: readManifest(manifestPath)) {
+        manifestWeights[entry.instanceFile] = entry.weight();
+    }
+
+    vector<double> weights;
+    for (const string &file: instanceFiles) {
+        double weight = 1.0;
+        auto it = manifestWeights.find(file);
+        if (it != manifestWeights.end()) {
+            weight = it->second;
+        } else {
+            readInstanceWeight((fs::path(instancesDir) / file).string(), weight);
+        }
+        weights.push_back(weight);
+    }
+    return weights;
+}
+
+BudgetScheduler::BudgetScheduler(double totalSeconds, int numLanes, const vector<double> &weights)
+    : startTime(chrono::steady_clock::now()), totalSeconds(totalSeconds), weights(weights),
+      allotted(weights.size(), 0.0) {
+    int lanes = max(1, min(numLanes, (int) weights.size()));
+    poolSeconds = totalSeconds * lanes;
+    pendingWeight = accumulate(weights.begin(), weights.end(), 0.0);
+
+    runOrder.resize(weights.size());
+    iota(runOrder.begin(), runOrder.end(), 0);
+    stable_sort(runOrder.begin(), runOrder.end(), [&](int a, int b) { return weights[a] > weights[b]; });
+}
+
+double BudgetScheduler::acquire(int i) {
+    lock_guard<mutex> lock(budgetMutex);
+
+    // Parte proporcional do que resta entre as execuções que ainda não começaram
+    double share = (pendingWeight > 0.0) ? poolSeconds * weights[i] / pendingWeight : 0.0;
+    pendingWeight -= weights[i];
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    double slice = max(0.0, min(share, totalSeconds - elapsed));
+
+    poolSeconds -= slice;
+    allotted[i] = slice;
+    return slice;
+}
+
+void BudgetScheduler::release(int i, double usedSeconds) {
+    lock_guard<mutex> lock(budgetMutex);
+    poolSeconds += max(0.0, allotted[i] - usedSeconds);
+    allotted[i] = 0.0;
+}
@@ -0,0 +1,50 @@
+#ifndef BATCH_BUDGET_H
+#define BATCH_BUDGET_H
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <chrono>
+
+using namespace std;
+
+// ===== ORÇAMENTO DE TEMPO DO LOTE =====
+// Com --budget o lote inteiro tem um tempo de parede total, dividido entre as execuções pelo
+// tamanho da instância (jobs x estágios x máquinas). As execuções começam da maior para a menor
+// (longest-first entre as lanes do runBatch) e cada fatia é calculada só quando a execução
+// começa, a partir do que ainda resta: o tempo que uma execução anterior não usou (ex.: parou
+// pelo limite de gerações) volta para as seguintes.
+
+// Peso de cada arquivo de instância, pelo manifesto (benchmark_manifest.h) ou, para arquivos fora
+// dele, pelo cabeçalho da própria instância
+vector<double> instanceWeights(const string &manifestPath, const string &instancesDir,
+                               const vector<string> &instanceFiles);
+
+class BudgetScheduler {
+public:
+    // numLanes: execuções simultâneas (--jobs); weights: peso de cada execução do lote
+    BudgetScheduler(double totalSeconds, int numLanes, const vector<double> &weights);
+
+    // Índices das execuções do maior para o menor peso (empate: ordem original)
+    const vector<int> &order() const { return runOrder; }
+
+    // Fatia da execução i em segundos, descontada do orçamento restante; nunca passa do fim do lote.
+    // Com o lote esgotado devolve 0, que os solvers leem como "sem limite": os drivers pulam a
+    // execução em vez de repassar a fatia, então um solver com --budget nunca recebe tempo <= 0
+    double acquire(int i);
+
+    // Devolve ao orçamento a parte da fatia que a execução i não usou
+    void release(int i, double usedSeconds);
+
+private:
+    mutex budgetMutex;
+    chrono::steady_clock::time_point startTime;
+    double totalSeconds;
+    double poolSeconds;   // Segundos x lanes ainda não reservados
+    double pendingWeight; // Peso das execuções que ainda não começaram
+    vector<double> weights;
+    vector<double> allotted;
+    vector<int> runOrder;
+};
+
+#endif // BATCH_BUDGET_H
@@ -0,0 +1,49 @@
+#include "batch_runner.h"
+#include "console.h"
+#include "task_runtime.h"
+#include <sstream>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+void runBatch(int count, int numJobs, const function<void(int)> &task) {
+    if (numJobs <= 1 || count <= 1) {
+        for (int i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    vector<ostringstream> logs(count);
+    vector<char> finished(count, 0);
+    int nextToPrint = 0;
+    mutex printMutex;
+
+    // numJobs tarefas grossas no runtime, cada uma pegando o próximo índice livre em ordem
+    // crescente, então os logs saem com pouco atraso
+    atomic<int> nextIndex(0);
+    auto lane = [&] {
+        for (int i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+            {
+                ConsoleScope scope(logs[i]);
+                task(i);
+            }
+
+            lock_guard<mutex> lock(printMutex);
+            finished[i] = 1;
+            while (nextToPrint < count && finished[nextToPrint]) {
+                cout << logs[nextToPrint].str() << flush;
+                logs[nextToPrint].str(string());
+                nextToPrint++;
+            }
+        }
+    };
+
+    TaskRuntime &runtime = TaskRuntime::instance();
+    TaskGroup group;
+    for (int j = 0; j < min(numJobs, count); j++) {
+        runtime.spawn(group, lane, true);
+    }
+    runtime.wait(group, true);
+}
@@ -0,0 +1,18 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <functional>
+
+using namespace std;
+
+// ===== LOTE DE INSTÂNCIAS =====
+// Executa task(i) para i em [0, count) com até numJobs tarefas ao mesmo tempo, como tarefas
+// grossas do runtime compartilhado (task_runtime.h); threads sem instância roubam os laços
+// paralelos das instâncias em andamento.
+// Com numJobs <= 1 as tarefas rodam em ordem e imprimem direto no cout. Em paralelo, o
+// console() de cada tarefa é um log próprio, despejado inteiro no cout assim que ela e todas
+// as anteriores terminaram: a saída fica na mesma ordem da execução sequencial.
+// Cada tarefa deve escrever apenas no seu próprio resultado (ex.: results[i]).
+void runBatch(int count, int numJobs, const function<void(int)> &task);
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,108 @@
+#include "benchmark_manifest.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <numeric>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+int ManifestEntry::totalMachines() const {
+    return accumulate(machines.begin(), machines.end(), 0);
+}
+
+vector<ManifestEntry> readManifest(const string &path) {
+    vector<ManifestEntry> entries;
+    ifstream file(path);
+    string line;
+    string currentClass;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        if (line[0] == '#') {
+            // Cabeçalho de grupo: "# M: 20 jobs, 3 estágios, 2 instâncias"
+            size_t colon = line.find(':');
+            if (colon != string::npos) {
+                string name = line.substr(1, colon - 1);
+                name.erase(0, name.find_first_not_of(' '));
+                if (!name.empty() && name.find(' ') == string::npos) currentClass = name;
+            }
+            continue;
+        }
+
+        // Formato: ID instance_file permutation_file n_jobs n_stages [m1,m2,...] seed
+        istringstream fields(line);
+        ManifestEntry entry;
+        string machines;
+        if (!(fields >> entry.id >> entry.instanceFile >> entry.permutationFile >> entry.jobs >> entry.stages
+                     >> machines >> entry.seed)) {
+            continue;
+        }
+
+        replace(machines.begin(), machines.end(), '[', ' ');
+        replace(machines.begin(), machines.end(), ']', ' ');
+        replace(machines.begin(), machines.end(), ',', ' ');
+        istringstream counts(machines);
+        int count;
+        while (counts >> count) entry.machines.push_back(count);
+
+        if (entry.jobs <= 0 || (int) entry.machines.size() != entry.stages) continue;
+        entry.sizeClass = currentClass;
+        entries.push_back(entry);
+    }
+
+    stable_sort(entries.begin(), entries.end(),
+                [](const ManifestEntry &a, const ManifestEntry &b) { return a.id < b.id; });
+    return entries;
+}
+
+string defaultManifestPath(const string &instancesDir) {
+    fs::path dir = fs::absolute(instancesDir).lexically_normal();
+    if (!dir.has_filename()) dir = dir.parent_path(); // "Instancias/" -> "Instancias"
+    return (dir.parent_path() / "benchmark_index.txt").string();
+}
+
+bool parseShard(const string &text, int &shardIndex, int &shardCount) {
+    size_t slash = text.find('/');
+    if (slash == string::npos) return false;
+    try {
+        shardIndex = stoi(text.substr(0, slash));
+        shardCount = stoi(text.substr(slash + 1));
+    } catch (const exception &) {
+        return false;
+    }
+    return shardCount >= 1 && shardIndex >= 1 && shardIndex <= shardCount;
+}
+
+vector<string> parseClassList(const string &text) {
+    vector<string> classes;
+    istringstream list(text);
+    string name;
+    while (getline(list, name, ',')) {
+        transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char) toupper(c); });
+        if (!name.empty()) classes.push_back(name);
+    }
+    return classes;
+}
+
+vector<ManifestEntry> selectEntries(const vector<ManifestEntry> &entries, const ManifestFilter &filter) {
+    vector<ManifestEntry> selected;
+    int position = 0;
+    for (const ManifestEntry &entry: entries) {
+        if (!filter.classes.empty() &&
+            find(filter.classes.begin(), filter.classes.end(), entry.sizeClass) == filter.classes.end()) {
+            continue;
+        }
+        if (entry.jobs < filter.minJobs) continue;
+        if (filter.maxJobs > 0 && entry.jobs > filter.maxJobs) continue;
+
+        if (position++ % filter.shardCount == filter.shardIndex - 1) selected.push_back(entry);
+    }
+    return selected;
+}
+
+string shardTag(const ManifestFilter &filter) {
+    if (filter.shardCount <= 1) return "";
+    return "_shard" + to_string(filter.shardIndex) + "of" + to_string(filter.shardCount);
+}
@@ -0,0 +1,65 @@
+#ifndef BENCHMARK_MANIFEST_H
+#define BENCHMARK_MANIFEST_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+// ===== MANIFESTO DO BENCHMARK =====
+// O benchmark_index.txt que o gerador.py grava ao lado do diretório de instâncias lista, por ID,
+// a instância, a permutação inicial, o tamanho e a semente usada na geração. Os drivers podem
+// tirar dele a lista do lote (em vez de varrer o diretório), filtrar por classe ou tamanho e
+// pegar só a fatia --shard k/N, para dividir um benchmark entre processos ou máquinas.
+
+struct ManifestEntry {
+    int id;
+    string instanceFile;    // Ex.: "I12.txt"
+    string permutationFile; // Ex.: "P12.txt"
+    int jobs;
+    int stages;
+    vector<int> machines;   // Máquinas por estágio
+    uint64_t seed;          // Semente do gerador.py para esta instância
+    string sizeClass;       // Classe do grupo ("S", "M", "L", "XG"...), do comentário "# <classe>: ..."
+
+    int totalMachines() const;
+
+    // Peso de tamanho usado pelo orçamento do lote: jobs x estágios x máquinas
+    double weight() const { return (double) jobs * stages * totalMachines(); }
+};
+
+// Filtros do lote; shardCount = 1 seleciona tudo
+struct ManifestFilter {
+    vector<string> classes; // Vazio = todas as classes
+    int minJobs;
+    int maxJobs;            // <= 0: sem limite superior
+    int shardIndex;         // k em --shard k/N, de 1 a shardCount
+    int shardCount;
+
+    ManifestFilter() : minJobs(0), maxJobs(0), shardIndex(1), shardCount(1) {}
+
+    bool active() const { return !classes.empty() || minJobs > 0 || maxJobs > 0 || shardCount > 1; }
+};
+
+// Entradas ordenadas por ID; vazio se o arquivo não existir
+vector<ManifestEntry> readManifest(const string &path);
+
+// benchmark_index.txt no diretório pai de instancesDir, onde o gerador.py o grava
+string defaultManifestPath(const string &instancesDir);
+
+// "k/N" com 1 <= k <= N
+bool parseShard(const string &text, int &shardIndex, int &shardCount);
+
+// Lista separada por vírgulas ("S,M") em maiúsculas
+vector<string> parseClassList(const string &text);
+
+// Aplica classe e faixa de jobs e depois fica com a fatia k/N da lista filtrada: a i-ésima entrada
+// (em ordem de ID) vai para o shard i mod N. A divisão depende só do manifesto e dos filtros, e o
+// rodízio mistura os tamanhos (os IDs vêm agrupados por classe)
+vector<ManifestEntry> selectEntries(const vector<ManifestEntry> &entries, const ManifestFilter &filter);
+
+// Sufixo dos arquivos de resumo de um shard ("_shard2of4"); vazio sem --shard
+string shardTag(const ManifestFilter &filter);
+
+#endif // BENCHMARK_MANIFEST_H
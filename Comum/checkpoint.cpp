@@ -0,0 +1,171 @@
+#include "checkpoint.h"
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+
+// Assinatura "TCCK" e versão do formato
+static const uint32_t CHECKPOINT_MAGIC = 0x4B434354;
+static const uint32_t CHECKPOINT_VERSION = 3;
+
+// ===== BUFFER =====
+
+void CheckpointBuffer::begin(CheckpointKind kind) {
+    data.clear();
+    put(CHECKPOINT_MAGIC);
+    put(CHECKPOINT_VERSION);
+    put(static_cast<uint32_t>(kind));
+}
+
+void CheckpointBuffer::putBytes(const void *source, size_t size) {
+    size_t offset = data.size();
+    data.resize(offset + size);
+    if (size > 0) memcpy(data.data() + offset, source, size);
+}
+
+void CheckpointBuffer::putString(const string &text) {
+    put<uint64_t>(text.size());
+    putArray(text.data(), text.size());
+}
+
+// ===== LEITURA =====
+
+bool CheckpointReader::open(const string &path, CheckpointKind kind) {
+    data.clear();
+    offset = 0;
+    valid = false;
+
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file.is_open()) return false;
+
+    streamsize size = file.tellg();
+    if (size <= 0) return false;
+    data.resize((size_t) size);
+    file.seekg(0);
+    if (!file.read(data.data(), size)) return false;
+
+    valid = true;
+    uint32_t magic = 0, version = 0, storedKind = 0;
+    get(magic);
+    get(version);
+    get(storedKind);
+    if (!valid || magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION ||
+        storedKind != static_cast<uint32_t>(kind)) {
+        valid = false;
+    }
+    return valid;
+}
+
+bool CheckpointReader::getBytes(void *dest, size_t size) {
+    if (!valid || size > data.size() - offset) {
+        valid = false;
+        return false;
+    }
+    if (size > 0) memcpy(dest, data.data() + offset, size);
+    offset += size;
+    return true;
+}
+
+bool CheckpointReader::getString(string &text) {
+    uint64_t size = 0;
+    if (!get(size) || size > data.size() - offset) {
+        valid = false;
+        return false;
+    }
+    text.assign(data.data() + offset, (size_t) size);
+    offset += (size_t) size;
+    return true;
+}
+
+// ===== GRAVAÇÃO EM SEGUNDO PLANO =====
+
+CheckpointWriter::CheckpointWriter(const string &p)
+    : path(p), pending(false), writing(false), stopping(false), writtenCount(0), skippedCount(0) {
+    writerThread = thread(&CheckpointWriter::writerLoop, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        lock_guard<mutex> lock(mtx);
+        stopping = true;
+    }
+    wakeCv.notify_one();
+    writerThread.join();
+}
+
+bool CheckpointWriter::submit() {
+    {
+        lock_guard<mutex> lock(mtx);
+        if (pending || writing) {
+            skippedCount++;
+            return false;
+        }
+        front.swap(back);
+        pending = true;
+    }
+    wakeCv.notify_one();
+    return true;
+}
+
+void CheckpointWriter::submitAndWait() {
+    {
+        unique_lock<mutex> lock(mtx);
+        idleCv.wait(lock, [&] { return !pending && !writing; });
+        front.swap(back);
+        pending = true;
+    }
+    wakeCv.notify_one();
+
+    unique_lock<mutex> lock(mtx);
+    idleCv.wait(lock, [&] { return !pending && !writing; });
+}
+
+int CheckpointWriter::written() const {
+    lock_guard<mutex> lock(mtx);
+    return writtenCount;
+}
+
+void CheckpointWriter::writerLoop() {
+    unique_lock<mutex> lock(mtx);
+    while (true) {
+        wakeCv.wait(lock, [&] { return pending || stopping; });
+        if (!pending) return;
+
+        pending = false;
+        writing = true;
+        lock.unlock();
+
+        bool ok = writeFile(back);
+
+        lock.lock();
+        writing = false;
+        if (ok) writtenCount++;
+        idleCv.notify_all();
+    }
+}
+
+bool CheckpointWriter::writeFile(const CheckpointBuffer &buffer) const {
+    string tmpPath = path + ".tmp";
+    {
+        ofstream file(tmpPath, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            cerr << "AVISO: Nao foi possivel criar checkpoint " << tmpPath << endl;
+            return false;
+        }
+        file.write(buffer.bytes().data(), (streamsize) buffer.bytes().size());
+        if (!file) {
+            cerr << "AVISO: Falha ao gravar checkpoint " << tmpPath << endl;
+            return false;
+        }
+    }
+
+    // Substitui o checkpoint anterior de uma vez (atômico em POSIX)
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        // Windows não sobrescreve no rename
+        remove(path.c_str());
+        if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+            cerr << "AVISO: Falha ao substituir checkpoint " << path << endl;
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,173 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include <algorithm>
+
+using namespace std;
+
+// ===== CHECKPOINTS BINÁRIOS =====
+// Arquivo: cabeçalho (assinatura, versão, tipo do solver) seguido dos campos na ordem em que
+// foram escritos. Sem marcação de campos: quem lê conhece o formato do próprio solver e confere
+// as dimensões (jobs, população) antes de aceitar o checkpoint.
+
+enum class CheckpointKind : uint32_t {
+    GA = 1,
+    PSO = 2
+};
+
+// Bytes de um checkpoint em montagem
+class CheckpointBuffer {
+public:
+    // Descarta o conteúdo anterior (mantendo a capacidade) e escreve o cabeçalho
+    void begin(CheckpointKind kind);
+
+    template<typename T>
+    void put(const T &value) {
+        static_assert(is_trivially_copyable<T>::value, "put exige tipo trivialmente copiavel");
+        putBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void putArray(const T *values, size_t count) {
+        static_assert(is_trivially_copyable<T>::value, "putArray exige tipo trivialmente copiavel");
+        putBytes(values, count * sizeof(T));
+    }
+
+    // Tamanho seguido dos elementos
+    template<typename T>
+    void putVector(const vector<T> &values) {
+        put<uint64_t>(values.size());
+        putArray(values.data(), values.size());
+    }
+
+    void putString(const string &text);
+
+    // Estado completo do gerador (RandomStream e afins), pelo operator<< do próprio gerador
+    template<typename Rng>
+    void putRng(const Rng &rng) {
+        ostringstream state;
+        state << rng;
+        putString(state.str());
+    }
+
+    const vector<char> &bytes() const { return data; }
+
+    void swap(CheckpointBuffer &other) { data.swap(other.data); }
+
+private:
+    vector<char> data;
+
+    void putBytes(const void *source, size_t size);
+};
+
+// Leitura sequencial de um checkpoint; qualquer campo truncado deixa ok() falso
+class CheckpointReader {
+public:
+    // Lê o arquivo inteiro e confere o cabeçalho; falso se não existe ou é de outro formato
+    bool open(const string &path, CheckpointKind kind);
+
+    bool ok() const { return valid; }
+
+    template<typename T>
+    bool get(T &value) {
+        static_assert(is_trivially_copyable<T>::value, "get exige tipo trivialmente copiavel");
+        return getBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    bool getArray(T *values, size_t count) {
+        static_assert(is_trivially_copyable<T>::value, "getArray exige tipo trivialmente copiavel");
+        return getBytes(values, count * sizeof(T));
+    }
+
+    template<typename T>
+    bool getVector(vector<T> &values) {
+        uint64_t size = 0;
+        if (!get(size) || size > (data.size() - offset) / max<size_t>(1, sizeof(T))) {
+            valid = false;
+            return false;
+        }
+        values.resize(size);
+        return getArray(values.data(), values.size());
+    }
+
+    bool getString(string &text);
+
+    template<typename Rng>
+    bool getRng(Rng &rng) {
+        string text;
+        if (!getString(text)) return false;
+        istringstream state(text);
+        state >> rng;
+        if (state.fail()) valid = false;
+        return valid;
+    }
+
+private:
+    vector<char> data;
+    size_t offset = 0;
+    bool valid = false;
+
+    bool getBytes(void *dest, size_t size);
+};
+
+// Grava checkpoints numa thread de fundo com buffer duplo: o laço de busca monta o próximo
+// checkpoint em buffer() enquanto a thread grava o anterior. submit() só troca os buffers
+// sob o mutex e nunca espera pelo disco; se a gravação anterior ainda não terminou, o
+// checkpoint é descartado e o próximo intervalo tenta de novo.
+// O arquivo é escrito em <path>.tmp e renomeado, então um processo interrompido no meio
+// da gravação deixa o checkpoint anterior intacto.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const string &path);
+
+    // Grava o checkpoint pendente, se houver, e encerra a thread
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    // Buffer de frente, preenchido pelo laço de busca
+    CheckpointBuffer &buffer() { return front; }
+
+    // Entrega o buffer de frente à thread de gravação; falso se ela ainda estava ocupada
+    bool submit();
+
+    // Espera a gravação em andamento e grava o buffer de frente (fim da execução)
+    void submitAndWait();
+
+    int written() const;
+
+    int skipped() const { return skippedCount; }
+
+private:
+    string path;
+    CheckpointBuffer front; // Só o laço de busca acessa
+    CheckpointBuffer back;  // Da thread de gravação enquanto pending ou writing
+
+    mutable mutex mtx;
+    condition_variable wakeCv;
+    condition_variable idleCv;
+    bool pending;
+    bool writing;
+    bool stopping;
+    int writtenCount;
+    int skippedCount;
+    thread writerThread;
+
+    void writerLoop();
+
+    bool writeFile(const CheckpointBuffer &buffer) const;
+};
+
+#endif // CHECKPOINT_H
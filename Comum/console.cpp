@@ -0,0 +1,16 @@
+#include "console.h"
+
+// nullptr: a thread escreve direto no cout
+static thread_local ostream *threadConsole = nullptr;
+
+ostream &console() {
+    return threadConsole ? *threadConsole : cout;
+}
+
+ConsoleScope::ConsoleScope(ostream &out) : previous(threadConsole) {
+    threadConsole = &out;
+}
+
+ConsoleScope::~ConsoleScope() {
+    threadConsole = previous;
+}
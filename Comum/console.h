@@ -0,0 +1,30 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <iostream>
+
+using namespace std;
+
+// ===== SAÍDA DE CONSOLE =====
+// Os solvers escrevem em console() em vez de cout. Na execução sequencial console() é o próprio
+// cout; no lote paralelo (runBatch) cada instância escreve no seu próprio log.
+// O redirecionamento vale só para a thread atual: uma thread criada pelo solver que imprime
+// precisa de um ConsoleScope com o console() de quem a criou.
+ostream &console();
+
+// Redireciona console() da thread atual para out enquanto existir
+class ConsoleScope {
+public:
+    explicit ConsoleScope(ostream &out);
+
+    ~ConsoleScope();
+
+    ConsoleScope(const ConsoleScope &) = delete;
+
+    ConsoleScope &operator=(const ConsoleScope &) = delete;
+
+private:
+    ostream *previous;
+};
+
+#endif // CONSOLE_H
@@ -0,0 +1,22 @@
+#ifndef ELITE_PORT_H
+#define ELITE_PORT_H
+
+#include <vector>
+
+using namespace std;
+
+// ===== TROCA DE ELITES =====
+// Canal pelo qual um otimizador publica o seu melhor e recebe o de outros, sem esperar por eles:
+// MigrationLink (ilhas em outros processos) e SharedIncumbent (GA e PSO no portfólio).
+// Permutações com os IDs dos jobs a partir de 1, como no decodificador.
+class ElitePort {
+public:
+    virtual ~ElitePort() = default;
+
+    virtual void publish(const vector<int> &permutation, double fitness) = 0;
+
+    // false se não há elite novo
+    virtual bool receive(vector<int> &permutation, double &fitness) = 0;
+};
+
+#endif // ELITE_PORT_H
@@ -0,0 +1,462 @@
+#include "migration_link.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+static const uint32_t HEADER_BYTES = 20;          // tag + fitness + número de jobs
+static const uint32_t MAX_FRAME_BYTES = 1u << 24; // Mais que isso só pode ser lixo na conexão
+static const size_t MAX_ARRIVALS = 16;            // Fila de chegada: os mais antigos dão lugar aos novos
+static const double RETRY_SECONDS = 0.2;          // Espera entre tentativas de conexão a um vizinho
+
+static double monotonicSeconds() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void putU32(vector<char> &out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) out.push_back((char) ((value >> shift) & 0xFF));
+}
+
+static void putU64(vector<char> &out, uint64_t value) {
+    for (int shift = 56; shift >= 0; shift -= 8) out.push_back((char) ((value >> shift) & 0xFF));
+}
+
+static uint32_t getU32(const char *data) {
+    const unsigned char *bytes = (const unsigned char *) data;
+    return ((uint32_t) bytes[0] << 24) | ((uint32_t) bytes[1] << 16) | ((uint32_t) bytes[2] << 8) | bytes[3];
+}
+
+static uint64_t getU64(const char *data) {
+    return ((uint64_t) getU32(data) << 32) | getU32(data + 4);
+}
+
+static vector<char> encodeFrame(uint64_t tag, const vector<int> &permutation, double fitness) {
+    uint64_t fitnessBits;
+    memcpy(&fitnessBits, &fitness, sizeof(fitnessBits));
+
+    vector<char> frame;
+    frame.reserve(4 + HEADER_BYTES + 4 * permutation.size());
+    putU32(frame, HEADER_BYTES + 4 * (uint32_t) permutation.size());
+    putU64(frame, tag);
+    putU64(frame, fitnessBits);
+    putU32(frame, (uint32_t) permutation.size());
+    for (int job: permutation) putU32(frame, (uint32_t) job);
+    return frame;
+}
+
+uint64_t migrationTag(const string &instanceFile, int replication) {
+    // FNV-1a de "<instância>#<replicação>"
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c: instanceFile + "#" + to_string(replication)) {
+        hash ^= c;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+vector<string> parseAddressList(const string &text) {
+    vector<string> addresses;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == string::npos) comma = text.size();
+        if (comma > start) addresses.push_back(text.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return addresses;
+}
+
+MigrationLink::MigrationLink()
+    : listenFd(-1), wakeFds{-1, -1}, currentTag(0), running(false), sent(0), received(0) {}
+
+MigrationLink::~MigrationLink() {
+    stop();
+}
+
+void MigrationLink::beginRun(uint64_t tag) {
+    lock_guard<mutex> lock(linkMutex);
+    currentTag = tag;
+    arrivals.clear();
+    for (Peer &peer: peers) peer.pending.clear();
+}
+
+void MigrationLink::publish(const vector<int> &permutation, double fitness) {
+    if (!running.load()) return;
+
+    {
+        lock_guard<mutex> lock(linkMutex);
+        vector<char> frame = encodeFrame(currentTag, permutation, fitness);
+        for (Peer &peer: peers) peer.pending = frame;
+    }
+
+#ifndef _WIN32
+    char signal = 1;
+    (void) !write(wakeFds[1], &signal, 1); // Pipe cheio já garante que a thread vai acordar
+#endif
+}
+
+bool MigrationLink::receive(vector<int> &permutation, double &fitness) {
+    lock_guard<mutex> lock(linkMutex);
+    if (arrivals.empty()) return false;
+    permutation = move(arrivals.front().permutation);
+    fitness = arrivals.front().fitness;
+    arrivals.pop_front();
+    return true;
+}
+
+#ifdef _WIN32
+
+bool MigrationLink::start(const string &, const vector<string> &) {
+    cerr << "ERRO: A migracao entre processos requer sockets POSIX (Linux ou macOS)" << endl;
+    return false;
+}
+
+void MigrationLink::stop() {}
+
+void MigrationLink::ioLoop() {}
+
+void MigrationLink::connectPeer(Peer &, double) {}
+
+void MigrationLink::flushPeer(Peer &, double) {}
+
+bool MigrationLink::readInbound(Inbound &) { return false; }
+
+void MigrationLink::closePeer(Peer &, double) {}
+
+#else
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS: SO_NOSIGPIPE no socket
+#endif
+
+// "unix:/caminho" ou "tcp:host:porta"
+static bool resolveAddress(const string &address, bool passive, sockaddr_storage &storage, socklen_t &length) {
+    memset(&storage, 0, sizeof(storage));
+
+    if (address.rfind("unix:", 0) == 0) {
+        string path = address.substr(5);
+        sockaddr_un *unixAddress = (sockaddr_un *) &storage;
+        if (path.empty() || path.size() >= sizeof(unixAddress->sun_path)) return false;
+        unixAddress->sun_family = AF_UNIX;
+        memcpy(unixAddress->sun_path, path.c_str(), path.size() + 1);
+        length = sizeof(sockaddr_un);
+        return true;
+    }
+
+    if (address.rfind("tcp:", 0) == 0) {
+        string hostPort = address.substr(4);
+        size_t colon = hostPort.rfind(':');
+        if (colon == string::npos || colon + 1 == hostPort.size()) return false;
+        string host = hostPort.substr(0, colon);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = passive ? AI_PASSIVE : 0;
+        addrinfo *result = nullptr;
+        if (getaddrinfo(host.empty() ? nullptr : host.c_str(), hostPort.substr(colon + 1).c_str(), &hints,
+                        &result) != 0 || !result) {
+            return false;
+        }
+        memcpy(&storage, result->ai_addr, result->ai_addrlen);
+        length = result->ai_addrlen;
+        freeaddrinfo(result);
+        return true;
+    }
+
+    return false;
+}
+
+static void configureSocket(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+// Elites são quadros pequenos e urgentes: sem Nagle nas conexões TCP
+static void disableNagle(int fd, const sockaddr_storage &storage) {
+    if (storage.ss_family == AF_UNIX) return;
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+bool MigrationLink::start(const string &listenAddr, const vector<string> &peerAddresses) {
+    if (running.load()) return false;
+
+    sockaddr_storage storage;
+    socklen_t length;
+    if (!resolveAddress(listenAddr, true, storage, length)) {
+        cerr << "ERRO: Endereco de migracao invalido: " << listenAddr << endl;
+        return false;
+    }
+    for (const string &address: peerAddresses) {
+        sockaddr_storage peerStorage;
+        socklen_t peerLength;
+        if (!resolveAddress(address, false, peerStorage, peerLength)) {
+            cerr << "ERRO: Endereco de migracao invalido: " << address << endl;
+            return false;
+        }
+    }
+
+    // Um socket Unix que sobrou de uma execução anterior impede o bind
+    if (storage.ss_family == AF_UNIX) unlink(((sockaddr_un *) &storage)->sun_path);
+
+    listenFd = socket(storage.ss_family, SOCK_STREAM, 0);
+    int on = 1;
+    if (listenFd >= 0) setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (listenFd < 0 || ::bind(listenFd, (sockaddr *) &storage, length) != 0 || listen(listenFd, 16) != 0) {
+        cerr << "ERRO: Nao foi possivel escutar em " << listenAddr << ": " << strerror(errno) << endl;
+        if (listenFd >= 0) close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    configureSocket(listenFd);
+
+    if (pipe(wakeFds) != 0) {
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    configureSocket(wakeFds[0]);
+    configureSocket(wakeFds[1]);
+
+    listenAddress = listenAddr;
+    peers.assign(peerAddresses.size(), Peer());
+    for (size_t i = 0; i < peerAddresses.size(); i++) peers[i].address = peerAddresses[i];
+
+    running.store(true);
+    ioThread = thread(&MigrationLink::ioLoop, this);
+    return true;
+}
+
+void MigrationLink::stop() {
+    if (!running.exchange(false)) return;
+
+    char signal = 1;
+    (void) !write(wakeFds[1], &signal, 1);
+    ioThread.join();
+
+    for (Peer &peer: peers) {
+        if (peer.fd >= 0) close(peer.fd);
+        peer.fd = -1;
+    }
+    for (Inbound &connection: inbound) close(connection.fd);
+    inbound.clear();
+    close(listenFd);
+    close(wakeFds[0]);
+    close(wakeFds[1]);
+    listenFd = wakeFds[0] = wakeFds[1] = -1;
+
+    if (listenAddress.rfind("unix:", 0) == 0) unlink(listenAddress.substr(5).c_str());
+}
+
+void MigrationLink::connectPeer(Peer &peer, double now) {
+    sockaddr_storage storage;
+    socklen_t length;
+    peer.retryAt = now + RETRY_SECONDS;
+    if (!resolveAddress(peer.address, false, storage, length)) return;
+
+    int fd = socket(storage.ss_family, SOCK_STREAM, 0);
+    if (fd < 0) return;
+    configureSocket(fd);
+    disableNagle(fd, storage);
+
+    if (connect(fd, (sockaddr *) &storage, length) == 0) {
+        peer.fd = fd;
+        peer.connecting = false;
+    } else if (errno == EINPROGRESS) {
+        peer.fd = fd;
+        peer.connecting = true;
+    } else {
+        close(fd); // Vizinho ainda não está escutando: nova tentativa em RETRY_SECONDS
+    }
+}
+
+void MigrationLink::closePeer(Peer &peer, double now) {
+    if (peer.fd >= 0) close(peer.fd);
+    peer.fd = -1;
+    peer.connecting = false;
+    peer.output.clear(); // Um quadro pela metade não é retomado: o vizinho descarta o que recebeu
+    peer.outputOffset = 0;
+    peer.retryAt = now + RETRY_SECONDS;
+}
+
+void MigrationLink::flushPeer(Peer &peer, double now) {
+    while (peer.outputOffset < peer.output.size()) {
+        ssize_t written = send(peer.fd, peer.output.data() + peer.outputOffset,
+                               peer.output.size() - peer.outputOffset, MSG_NOSIGNAL);
+        if (written > 0) {
+            peer.outputOffset += written;
+        } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return;
+        } else {
+            closePeer(peer, now);
+            return;
+        }
+    }
+    peer.output.clear();
+    peer.outputOffset = 0;
+    sent++;
+}
+
+bool MigrationLink::readInbound(Inbound &connection) {
+    char buffer[65536];
+    bool open = true;
+    while (true) {
+        ssize_t count = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (count > 0) {
+            connection.input.insert(connection.input.end(), buffer, buffer + count);
+        } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            break;
+        } else {
+            open = false;
+            break;
+        }
+    }
+
+    // Quadros completos; um resto incompleto espera a próxima leitura
+    size_t offset = 0;
+    vector<char> &input = connection.input;
+    while (input.size() - offset >= 4) {
+        uint32_t frameBytes = getU32(input.data() + offset);
+        if (frameBytes < HEADER_BYTES || frameBytes > MAX_FRAME_BYTES) return false;
+        if (input.size() - offset - 4 < frameBytes) break;
+
+        const char *payload = input.data() + offset + 4;
+        offset += 4 + frameBytes;
+
+        uint64_t tag = getU64(payload);
+        uint64_t fitnessBits = getU64(payload + 8);
+        uint32_t numJobs = getU32(payload + 16);
+        if (frameBytes != HEADER_BYTES + 4 * (uint64_t) numJobs) return false;
+
+        Migrant migrant;
+        memcpy(&migrant.fitness, &fitnessBits, sizeof(migrant.fitness));
+        migrant.permutation.resize(numJobs);
+        vector<char> seen(numJobs + 1, 0);
+        bool valid = numJobs > 0;
+        for (uint32_t i = 0; i < numJobs && valid; i++) {
+            uint32_t job = getU32(payload + HEADER_BYTES + 4 * i);
+            valid = job >= 1 && job <= numJobs && !seen[job];
+            if (valid) seen[job] = 1;
+            migrant.permutation[i] = (int) job;
+        }
+        if (!valid) continue;
+
+        lock_guard<mutex> lock(linkMutex);
+        if (tag != currentTag) continue; // Elite de outra instância ou replicação
+        arrivals.push_back(move(migrant));
+        if (arrivals.size() > MAX_ARRIVALS) arrivals.pop_front();
+        received++;
+    }
+    input.erase(input.begin(), input.begin() + offset);
+    return open;
+}
+
+void MigrationLink::ioLoop() {
+    vector<pollfd> fds;
+    while (running.load()) {
+        double now = monotonicSeconds();
+
+        // Reconexões (fora da trava: getaddrinfo pode demorar) e próximo quadro de cada vizinho livre
+        for (Peer &peer: peers) {
+            if (peer.fd < 0 && now >= peer.retryAt) connectPeer(peer, now);
+        }
+        {
+            lock_guard<mutex> lock(linkMutex);
+            for (Peer &peer: peers) {
+                if (peer.fd >= 0 && !peer.connecting && peer.output.empty() && !peer.pending.empty()) {
+                    peer.output.swap(peer.pending);
+                    peer.pending.clear();
+                    peer.outputOffset = 0;
+                }
+            }
+        }
+
+        // [pipe, escuta, vizinhos..., conexões recebidas...]
+        fds.clear();
+        fds.push_back({wakeFds[0], POLLIN, 0});
+        fds.push_back({listenFd, POLLIN, 0});
+        for (const Peer &peer: peers) {
+            short events = POLLIN; // Vizinhos nunca escrevem: legível = conexão fechada
+            if (peer.connecting || !peer.output.empty()) events |= POLLOUT;
+            fds.push_back({peer.fd, events, 0}); // fd negativo é ignorado pelo poll
+        }
+        for (const Inbound &connection: inbound) {
+            fds.push_back({connection.fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), (int) (RETRY_SECONDS * 1000)) < 0 && errno != EINTR) break;
+        now = monotonicSeconds();
+
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            while (read(wakeFds[0], drain, sizeof(drain)) > 0) {}
+        }
+
+        for (size_t i = 0; i < peers.size(); i++) {
+            Peer &peer = peers[i];
+            short revents = fds[2 + i].revents;
+            if (peer.fd < 0 || revents == 0) continue;
+
+            if (peer.connecting) {
+                int error = 0;
+                socklen_t errorLength = sizeof(error);
+                getsockopt(peer.fd, SOL_SOCKET, SO_ERROR, &error, &errorLength);
+                if (error != 0) {
+                    closePeer(peer, now);
+                    continue;
+                }
+                if (!(revents & POLLOUT)) continue;
+                peer.connecting = false;
+            }
+
+            if (revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL)) {
+                char probe[256];
+                ssize_t count = recv(peer.fd, probe, sizeof(probe), 0);
+                if (count == 0 || (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    closePeer(peer, now);
+                    continue;
+                }
+            }
+            if (!peer.output.empty()) flushPeer(peer, now);
+        }
+
+        for (size_t i = 0, slot = 2 + peers.size(); i < inbound.size(); slot++) {
+            if (fds[slot].revents != 0 && !readInbound(inbound[i])) {
+                close(inbound[i].fd);
+                inbound.erase(inbound.begin() + i);
+            } else {
+                i++;
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            while (true) {
+                sockaddr_storage storage;
+                socklen_t length = sizeof(storage);
+                int fd = accept(listenFd, (sockaddr *) &storage, &length);
+                if (fd < 0) break;
+                configureSocket(fd);
+                disableNagle(fd, storage);
+                inbound.push_back({fd, {}});
+            }
+        }
+    }
+}
+
+#endif
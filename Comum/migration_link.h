@@ -0,0 +1,115 @@
+#ifndef MIGRATION_LINK_H
+#define MIGRATION_LINK_H
+
+#include "elite_port.h"
+#include <vector>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+// ===== MIGRAÇÃO ENTRE PROCESSOS =====
+// Ilhas em processos separados (na mesma máquina ou em outras) trocam elites por sockets Unix ou
+// TCP. Cada processo escuta num endereço e se conecta aos vizinhos da topologia: as conexões que
+// ele abre só enviam e as que ele aceita só recebem, então um anel é "cada um aponta para o
+// próximo" e a topologia completa é "cada um aponta para todos os outros".
+//
+// Endereços: "unix:/tmp/ilha0.sock" ou "tcp:host:porta" (para escutar, "tcp:0.0.0.0:porta").
+//
+// Protocolo: quadros [tamanho uint32][conteúdo], inteiros em big-endian. Conteúdo: tag uint64 da
+// execução, fitness (bits do double, uint64), número de jobs uint32 e a permutação com os IDs dos
+// jobs a partir de 1 (uint32 cada), o mesmo formato do GA e do PSO. Quadros de outra tag (outra
+// instância ou replicação) ou que não são permutação são descartados.
+//
+// Uma thread de rede faz todo o I/O com sockets não bloqueantes: publish() só troca o próximo
+// quadro de cada vizinho e receive() só tira da fila de chegada, então a evolução nunca espera a
+// rede. Vizinhos ainda não iniciados (ou que caíram) são reconectados periodicamente; enquanto
+// isso, só o elite mais recente fica guardado para eles.
+
+class MigrationLink : public ElitePort {
+public:
+    MigrationLink();
+
+    ~MigrationLink();
+
+    MigrationLink(const MigrationLink &) = delete;
+    MigrationLink &operator=(const MigrationLink &) = delete;
+
+    // Escuta em listenAddress, conecta-se a peerAddresses e inicia a thread de rede; false (com a
+    // mensagem de erro no cerr) se o endereço for inválido ou não puder ser aberto
+    bool start(const string &listenAddress, const vector<string> &peerAddresses);
+
+    void stop();
+
+    bool isRunning() const { return running.load(); }
+
+    // Nova execução (instância x replicação): descarta elites pendentes e chegados da anterior
+    void beginRun(uint64_t tag);
+
+    // Não bloqueia: o elite passa a ser o próximo quadro de cada vizinho, no lugar do que ainda não
+    // tinha saído
+    void publish(const vector<int> &permutation, double fitness) override;
+
+    // Próximo elite recebido da execução atual; false se a fila estiver vazia
+    bool receive(vector<int> &permutation, double &fitness) override;
+
+    // Contadores desde start(), para o relatório
+    long long framesSent() const { return sent.load(); }
+    long long framesReceived() const { return received.load(); }
+
+private:
+    struct Peer {
+        string address;
+        int fd = -1;
+        bool connecting = false;
+        vector<char> pending; // Próximo quadro, ainda não iniciado (substituído a cada publish)
+        vector<char> output;  // Quadro em envio
+        size_t outputOffset = 0;
+        double retryAt = 0.0; // Relógio monotônico (s) da próxima tentativa de conexão
+    };
+
+    struct Inbound {
+        int fd;
+        vector<char> input;
+    };
+
+    struct Migrant {
+        vector<int> permutation;
+        double fitness;
+    };
+
+    string listenAddress;
+    int listenFd;
+    int wakeFds[2]; // Pipe que acorda a thread de rede a cada publish
+    vector<Peer> peers;
+    vector<Inbound> inbound;
+    deque<Migrant> arrivals;
+    uint64_t currentTag;
+    mutex linkMutex; // Protege peers[].pending, arrivals e currentTag
+    thread ioThread;
+    atomic<bool> running;
+    atomic<long long> sent;
+    atomic<long long> received;
+
+    void ioLoop();
+
+    void connectPeer(Peer &peer, double now);
+
+    void flushPeer(Peer &peer, double now);
+
+    bool readInbound(Inbound &connection);
+
+    void closePeer(Peer &peer, double now);
+};
+
+// Tag de uma execução: processos que resolvem a mesma instância e replicação trocam elites entre si
+uint64_t migrationTag(const string &instanceFile, int replication);
+
+// Lista separada por vírgulas de endereços
+vector<string> parseAddressList(const string &text);
+
+#endif // MIGRATION_LINK_H
@@ -0,0 +1,79 @@
+#include "operator_bandit.h"
+#include <iomanip>
+#include <algorithm>
+
+void OperatorUsage::reset(int numArms) {
+    uses.assign(numArms, 0);
+    improvement.assign(numArms, 0.0);
+    nanoseconds.assign(numArms, 0);
+}
+
+void OperatorUsage::record(int arm, double gain, long long ns) {
+    uses[arm]++;
+    improvement[arm] += max(0.0, gain);
+    nanoseconds[arm] += ns;
+}
+
+void OperatorUsage::merge(const OperatorUsage &other) {
+    for (size_t a = 0; a < uses.size(); a++) {
+        uses[a] += other.uses[a];
+        improvement[a] += other.improvement[a];
+        nanoseconds[a] += other.nanoseconds[a];
+    }
+}
+
+OperatorBandit::OperatorBandit(const vector<string> &armNames, double minProb, double rate)
+    : names(armNames), quality(armNames.size(), 0.0), probability(armNames.size()),
+      minProbability(min(minProb, 1.0 / armNames.size())), learningRate(rate) {
+    for (auto &p: probability) p.store(1.0 / size(), memory_order_relaxed);
+    current.reset(size());
+}
+
+int OperatorBandit::select(double u) const {
+    double cumulative = 0.0;
+    for (int a = 0; a < size() - 1; a++) {
+        cumulative += probability[a].load(memory_order_relaxed);
+        if (u < cumulative) return a;
+    }
+    return size() - 1;
+}
+
+void OperatorBandit::endGeneration(int generation) {
+    int numArms = size();
+
+    for (int a = 0; a < numArms; a++) {
+        double credit = 0.0;
+        if (current.uses[a] > 0) {
+            // Operadores não usados na geração mantêm a qualidade anterior
+            credit = current.improvement[a] / max(1LL, current.nanoseconds[a]);
+            quality[a] += learningRate * (credit - quality[a]);
+        }
+        log.push_back({generation, a, current.uses[a], current.improvement[a], current.nanoseconds[a],
+                       credit, probability[a].load(memory_order_relaxed)});
+    }
+
+    double totalQuality = 0.0;
+    for (double q: quality) totalQuality += q;
+
+    for (int a = 0; a < numArms; a++) {
+        // Sem nenhuma melhoria registrada ainda, escolha uniforme
+        double share = totalQuality > 0.0 ? quality[a] / totalQuality : 1.0 / numArms;
+        probability[a].store(minProbability + (1.0 - numArms * minProbability) * share, memory_order_relaxed);
+    }
+
+    current.reset(numArms);
+}
+
+void OperatorBandit::writeLogHeader(ostream &out) {
+    // Probability é a probabilidade usada durante a geração; Credit é melhoria/ns
+    out << "Generation,Kind,Operator,Uses,Improvement,TimeNs,Credit,Probability\n";
+}
+
+void OperatorBandit::writeLog(ostream &out, const string &kind) const {
+    for (const LogRow &row: log) {
+        out << row.generation << "," << kind << "," << names[row.arm] << "," << row.uses << ","
+            << fixed << setprecision(2) << row.improvement << "," << row.nanoseconds << ","
+            << scientific << setprecision(4) << row.credit << ","
+            << fixed << setprecision(4) << row.probability << "\n";
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef OPERATOR_BANDIT_H
+#define OPERATOR_BANDIT_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ostream>
+#include <atomic>
+
+using namespace std;
+
+// ===== SELEÇÃO ADAPTATIVA DE OPERADORES =====
+
+// Nanossegundos desde o instante informado (relógio monotônico)
+inline long long nanosecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+}
+
+// Uso e melhoria acumulados por operador durante uma geração.
+// Cada thread mantém o seu e os acumuladores são somados no fim da geração.
+struct OperatorUsage {
+    vector<long long> uses;
+    vector<double> improvement;    // Soma das reduções de makespan obtidas
+    vector<long long> nanoseconds; // Tempo gasto pelo operador, incluindo a decodificação
+
+    void reset(int numArms);
+
+    void record(int arm, double gain, long long ns);
+
+    void merge(const OperatorUsage &other);
+};
+
+// Multi-armed bandit por probability matching. O crédito de um operador numa geração é
+// melhoria / nanossegundo; a qualidade é uma média móvel exponencial desse crédito e a
+// probabilidade de escolha é proporcional à qualidade, com um piso para continuar explorando.
+class OperatorBandit {
+public:
+    OperatorBandit(const vector<string> &armNames, double minProbability = 0.05, double learningRate = 0.3);
+
+    int size() const { return (int) names.size(); }
+
+    const string &name(int arm) const { return names[arm]; }
+
+    // Escolhe um operador a partir de u uniforme em [0, 1). As probabilidades são atômicas, então
+    // pode ser chamada por várias threads, inclusive durante um endGeneration concorrente.
+    int select(double u) const;
+
+    // Acumulador da geração corrente (uso sequencial)
+    OperatorUsage &usage() { return current; }
+
+    // Credita os operadores usados, atualiza as probabilidades e registra a geração no log
+    void endGeneration(int generation);
+
+    // Log longo: uma linha por geração e operador. kind identifica o bandit no arquivo
+    // (ex.: "Crossover" ou "Mutation"), para que vários bandits dividam o mesmo CSV.
+    static void writeLogHeader(ostream &out);
+
+    void writeLog(ostream &out, const string &kind) const;
+
+private:
+    struct LogRow {
+        int generation;
+        int arm;
+        long long uses;
+        double improvement;
+        long long nanoseconds;
+        double credit;
+        double probability;
+    };
+
+    vector<string> names;
+    vector<double> quality;
+    vector<atomic<double>> probability;
+    double minProbability;
+    double learningRate;
+    OperatorUsage current;
+    vector<LogRow> log;
+};
+
+#endif // OPERATOR_BANDIT_H
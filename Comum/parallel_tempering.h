@@ -0,0 +1,271 @@
+#ifndef PARALLEL_TEMPERING_H
+#define PARALLEL_TEMPERING_H
+
+#include "thread_pool.h"
+#include "permutation_moves.h"
+#include "console.h"
+#include "random_stream.h"
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <limits>
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+// ===== PARALLEL TEMPERING (REPLICA EXCHANGE) =====
+
+struct TemperingParameters {
+    int numReplicas;
+    double minTemperature;  // Réplica mais fria (mesma escala de makespan do simulated annealing do GA)
+    double maxTemperature;  // Réplica mais quente
+    int sweepsPerRound;     // Varreduras (n movimentos cada) por réplica entre as trocas
+    int numThreads;
+    double maxSeconds;      // <= 0: sem limite de tempo (com --budget nunca chega <= 0: os drivers
+                            // pulam a execução quando a fatia acaba)
+    int maxRounds;          // <= 0: sem limite de rodadas
+
+    TemperingParameters()
+        : numReplicas(8), minTemperature(1.0), maxTemperature(50.0), sweepsPerRound(1), numThreads(1),
+          maxSeconds(0.0), maxRounds(0) {}
+};
+
+// Estatísticas de uma rodada; avg e worst são do estado corrente das réplicas
+struct TemperingStats {
+    int round;
+    double bestFitness;
+    double avgFitness;
+    double worstFitness;
+    double elapsedTime;
+};
+
+// R réplicas numa escada geométrica de temperaturas, cada uma fazendo movimentos insert e
+// interchange com aceitação de Metropolis exp(-delta / T), a mesma regra de substituição do GA.
+// A cada rodada as réplicas andam em paralelo e depois vizinhas de temperatura trocam de
+// estado com probabilidade min(1, exp((f_i - f_j) * (1/T_i - 1/T_j))).
+//
+// Problem é o ProblemData do modelo; o solver usa apenas resetProblemData e decodeChromosome,
+// que têm a mesma assinatura nas implementações GA e PSO.
+template<typename Problem>
+class ParallelTempering {
+public:
+    ParallelTempering(const TemperingParameters &p, const Problem &data)
+        : params(p), problemData(data), numJobs(data.numJobs), verbose(true) {
+        params.numReplicas = max(2, params.numReplicas);
+        rng.seed(randomSeed());
+    }
+
+    void setVerbose(bool val) { verbose = val; }
+
+    // Fluxo principal (--seed); sem chamar, a semente vem do random_device
+    void setRandomStream(const RandomStream &stream) { rng = stream; }
+
+    // Sem seed (vetor vazio), cada réplica parte de uma permutação aleatória.
+    // Devolve a melhor permutação encontrada (0-based).
+    vector<int> run(const vector<int> &seedPermutation);
+
+    double getBestFitness() const { return bestFitness; }
+    const vector<int> &getBestPermutation() const { return bestPermutation; }
+    const vector<TemperingStats> &getHistory() const { return history; }
+    const vector<double> &getTemperatures() const { return temperatures; }
+
+    // Fração das trocas aceitas entre as temperaturas i e i + 1
+    double exchangeRate(int i) const {
+        return exchangeAttempts[i] > 0 ? (double) exchangeAccepted[i] / exchangeAttempts[i] : 0.0;
+    }
+
+private:
+    struct Replica {
+        vector<int> state;     // Permutação 0-based
+        vector<int> candidate; // Vizinho em avaliação
+        double fitness;
+        RandomStream rng;      // Por réplica: o resultado não depende do número de threads
+        vector<int> bestState;
+        double bestFitness;
+    };
+
+    // Contexto de decodificação por thread (o decodificador altera os dados do problema)
+    struct DecodeWorker {
+        Problem problemData;
+        vector<int> buffer;
+    };
+
+    TemperingParameters params;
+    Problem problemData;
+    int numJobs;
+    bool verbose;
+    RandomStream rng;
+
+    vector<double> temperatures;
+    vector<Replica> replicas; // replicas[i] está na temperatura temperatures[i]
+    vector<DecodeWorker> workers;
+    unique_ptr<ThreadPool> threadPool;
+
+    vector<long long> exchangeAttempts;
+    vector<long long> exchangeAccepted;
+
+    vector<int> bestPermutation;
+    double bestFitness;
+    vector<TemperingStats> history;
+
+    double evaluate(const vector<int> &permutation, DecodeWorker &worker);
+    void sweep(Replica &replica, double temperature, DecodeWorker &worker);
+    void exchange(int round);
+};
+
+template<typename Problem>
+double ParallelTempering<Problem>::evaluate(const vector<int> &permutation, DecodeWorker &worker) {
+    resetProblemData(worker.problemData);
+
+    // Converter para 1-based
+    worker.buffer.resize(numJobs);
+    for (int i = 0; i < numJobs; i++) {
+        worker.buffer[i] = permutation[i] + 1;
+    }
+    return decodeChromosome(worker.buffer, worker.problemData);
+}
+
+template<typename Problem>
+void ParallelTempering<Problem>::sweep(Replica &replica, double temperature, DecodeWorker &worker) {
+    int moves = params.sweepsPerRound * numJobs;
+
+    for (int m = 0; m < moves; m++) {
+        replica.candidate = replica.state;
+        if (replica.rng.uniform01() < 0.5) {
+            insertMove(replica.candidate.data(), numJobs, replica.rng);
+        } else {
+            interchangeMove(replica.candidate.data(), numJobs, replica.rng);
+        }
+
+        double candidateFitness = evaluate(replica.candidate, worker);
+        double delta = candidateFitness - replica.fitness;
+
+        if (delta <= 0.0 || replica.rng.uniform01() < exp(-delta / temperature)) {
+            replica.state.swap(replica.candidate);
+            replica.fitness = candidateFitness;
+
+            if (replica.fitness < replica.bestFitness) {
+                replica.bestFitness = replica.fitness;
+                replica.bestState = replica.state;
+            }
+        }
+    }
+}
+
+template<typename Problem>
+void ParallelTempering<Problem>::exchange(int round) {
+    // Pares pares e ímpares alternados entre rodadas, para que um estado possa atravessar a escada
+    for (int i = round % 2; i + 1 < params.numReplicas; i += 2) {
+        Replica &cold = replicas[i];
+        Replica &hot = replicas[i + 1];
+        double exponent = (cold.fitness - hot.fitness) * (1.0 / temperatures[i] - 1.0 / temperatures[i + 1]);
+
+        exchangeAttempts[i]++;
+        if (exponent >= 0.0 || rng.uniform01() < exp(exponent)) {
+            exchangeAccepted[i]++;
+            cold.state.swap(hot.state);
+            swap(cold.fitness, hot.fitness);
+        }
+    }
+}
+
+template<typename Problem>
+vector<int> ParallelTempering<Problem>::run(const vector<int> &seedPermutation) {
+    auto startTime = chrono::high_resolution_clock::now();
+    int numReplicas = params.numReplicas;
+
+    // Escada geométrica: razão constante entre temperaturas vizinhas
+    temperatures.resize(numReplicas);
+    double ratio = pow(params.maxTemperature / params.minTemperature, 1.0 / (numReplicas - 1));
+    for (int i = 0; i < numReplicas; i++) {
+        temperatures[i] = params.minTemperature * pow(ratio, i);
+    }
+
+    workers.clear();
+    workers.resize(max(1, params.numThreads));
+    for (DecodeWorker &worker: workers) {
+        worker.problemData = problemData;
+    }
+    threadPool.reset(workers.size() > 1 ? new ThreadPool((int) workers.size()) : nullptr);
+
+    replicas.clear();
+    replicas.resize(numReplicas);
+    bool seeded = (int) seedPermutation.size() == numJobs;
+    for (Replica &replica: replicas) {
+        replica.rng.seed(rng());
+        if (seeded) {
+            replica.state = seedPermutation;
+        } else {
+            replica.state.resize(numJobs);
+            iota(replica.state.begin(), replica.state.end(), 0);
+            replica.rng.shuffle(replica.state.begin(), replica.state.end());
+        }
+        replica.fitness = evaluate(replica.state, workers[0]);
+        replica.bestState = replica.state;
+        replica.bestFitness = replica.fitness;
+    }
+
+    exchangeAttempts.assign(numReplicas - 1, 0);
+    exchangeAccepted.assign(numReplicas - 1, 0);
+    bestFitness = numeric_limits<double>::max();
+    history.clear();
+
+    if (verbose) {
+        console() << "Executando parallel tempering (" << numReplicas << " replicas, T=" << fixed << setprecision(2)
+             << temperatures.front() << ".." << temperatures.back() << ", " << workers.size() << " threads)..."
+             << endl;
+    }
+
+    for (int round = 0; params.maxRounds <= 0 || round < params.maxRounds; round++) {
+        double elapsed = chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count();
+        if (params.maxSeconds > 0.0 && elapsed >= params.maxSeconds) break;
+
+        // Rodada 0 só registra o estado inicial
+        if (round > 0) {
+            auto body = [&](int r, int w) { sweep(replicas[r], temperatures[r], workers[w]); };
+            if (threadPool) {
+                threadPool->parallelFor(numReplicas, body);
+            } else {
+                for (int r = 0; r < numReplicas; r++) body(r, 0);
+            }
+            exchange(round);
+        }
+
+        TemperingStats stats;
+        stats.round = round;
+        stats.worstFitness = 0.0;
+        double sum = 0.0;
+        for (const Replica &replica: replicas) {
+            if (replica.bestFitness < bestFitness) {
+                bestFitness = replica.bestFitness;
+                bestPermutation = replica.bestState;
+            }
+            sum += replica.fitness;
+            stats.worstFitness = max(stats.worstFitness, replica.fitness);
+        }
+        stats.bestFitness = bestFitness;
+        stats.avgFitness = sum / numReplicas;
+        stats.elapsedTime = chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count();
+        history.push_back(stats);
+
+        if (verbose && round % 100 == 0) {
+            console() << "Rodada " << round << ": Best=" << stats.bestFitness << " Avg=" << stats.avgFitness
+                 << " Worst=" << stats.worstFitness << " Time=" << stats.elapsedTime << "s" << endl;
+        }
+    }
+
+    if (verbose) {
+        console() << "Taxa de troca entre temperaturas vizinhas:";
+        for (int i = 0; i + 1 < numReplicas; i++) {
+            console() << " " << setprecision(2) << exchangeRate(i);
+        }
+        console() << endl;
+    }
+
+    return bestPermutation;
+}
+
+#endif // PARALLEL_TEMPERING_H
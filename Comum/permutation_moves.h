@@ -0,0 +1,60 @@
+#ifndef PERMUTATION_MOVES_H
+#define PERMUTATION_MOVES_H
+
+#include <algorithm>
+
+using namespace std;
+
+// ===== MOVIMENTOS SOBRE PERMUTAÇÕES =====
+// Operadores de mutação do GA sobre um cromossomo de n genes, compartilhados com o
+// parallel tempering. Cada um consome o RNG (RandomStream) sempre na mesma ordem.
+
+// Insert: remove o gene de uma posição e o reinsere em outra
+template<typename Gene, typename Rng>
+void insertMove(Gene *chromosome, int n, Rng &rng) {
+    if (n < 2) return;
+
+    int pos1 = rng.uniformInt(0, n - 1);
+    int pos2 = rng.uniformInt(0, n - 1);
+
+    // Garantir que pos1 != pos2
+    while (pos1 == pos2) {
+        pos2 = rng.uniformInt(0, n - 1);
+    }
+
+    // Remover o job de pos1 e reinseri-lo em pos2 (ajustado pela remoção) é uma rotação do trecho
+    if (pos2 > pos1) pos2--;
+
+    if (pos2 > pos1) {
+        rotate(chromosome + pos1, chromosome + pos1 + 1, chromosome + pos2 + 1);
+    } else if (pos2 < pos1) {
+        rotate(chromosome + pos2, chromosome + pos1, chromosome + pos1 + 1);
+    }
+}
+
+// Interchange: troca os genes de duas posições quaisquer
+template<typename Gene, typename Rng>
+void interchangeMove(Gene *chromosome, int n, Rng &rng) {
+    if (n < 2) return;
+
+    int pos1 = rng.uniformInt(0, n - 1);
+    int pos2 = rng.uniformInt(0, n - 1);
+
+    // Garantir que pos1 != pos2
+    while (pos1 == pos2) {
+        pos2 = rng.uniformInt(0, n - 1);
+    }
+
+    swap(chromosome[pos1], chromosome[pos2]);
+}
+
+// Swap: troca dois genes adjacentes
+template<typename Gene, typename Rng>
+void adjacentSwapMove(Gene *chromosome, int n, Rng &rng) {
+    if (n < 2) return;
+
+    int pos = rng.uniformInt(0, n - 2);
+    swap(chromosome[pos], chromosome[pos + 1]);
+}
+
+#endif // PERMUTATION_MOVES_H
@@ -0,0 +1,147 @@
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <cstdint>
+#include <random>
+#include <istream>
+#include <ostream>
+#include <utility>
+
+using namespace std;
+
+// ===== FLUXOS DE NÚMEROS ALEATÓRIOS =====
+// xoshiro256** (Blackman e Vigna): 256 bits de estado, período 2^256 - 1 e poucas instruções por
+// número. Há duas formas de obter fluxos independentes a partir de uma mesma semente:
+//  - salto: jump() avança 2^128 passos e longJump() 2^192, para fluxos de vida longa
+//    (replicação, ilha);
+//  - contador: RandomStream(chave, contador) monta o estado a partir do par com SplitMix64 em
+//    O(1), para um fluxo por item de trabalho (par de pais, partícula). O resultado de um laço
+//    paralelo não depende de qual thread processou cada item, nem de quantas threads existem.
+// Satisfaz UniformRandomBitGenerator, mas o código quente usa below/uniformInt/uniform01 em
+// vez das distribuições da biblioteca padrão.
+class RandomStream {
+public:
+    using result_type = uint64_t;
+
+    RandomStream() { seed(0); }
+
+    explicit RandomStream(uint64_t seedValue) { seed(seedValue); }
+
+    RandomStream(uint64_t key, uint64_t counter) { seed(key ^ mix(counter + 0x6A09E667F3BCC909ULL)); }
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    void seed(uint64_t seedValue) {
+        // SplitMix64 espalha a semente pelos quatro blocos (o estado nunca fica todo zero)
+        for (uint64_t &word: state) {
+            seedValue += 0x9E3779B97F4A7C15ULL;
+            word = mix(seedValue);
+        }
+    }
+
+    result_type operator()() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    void jump() {
+        static const uint64_t JUMP[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+        applyJump(JUMP);
+    }
+
+    void longJump() {
+        static const uint64_t LONG_JUMP[] = {0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL,
+                                             0x77710069854EE241ULL, 0x39109BB02ACBE635ULL};
+        applyJump(LONG_JUMP);
+    }
+
+    // Inteiro uniforme em [0, range) pela redução multiplicativa de Lemire, sem viés: a divisão
+    // só acontece na rejeição, que é rara para os intervalos pequenos usados aqui
+    uint32_t below(uint32_t range) {
+        uint64_t product = (uint64_t) (uint32_t) ((*this)() >> 32) * range;
+        uint32_t low = (uint32_t) product;
+        if (low < range) {
+            uint32_t threshold = (uint32_t) -range % range;
+            while (low < threshold) {
+                product = (uint64_t) (uint32_t) ((*this)() >> 32) * range;
+                low = (uint32_t) product;
+            }
+        }
+        return (uint32_t) (product >> 32);
+    }
+
+    // Inteiro uniforme em [lo, hi]
+    int uniformInt(int lo, int hi) { return lo + (int) below((uint32_t) (hi - lo) + 1u); }
+
+    // Real uniforme em [0, 1) com 53 bits
+    double uniform01() { return (double) ((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+
+    double uniform(double lo, double hi) { return lo + (hi - lo) * uniform01(); }
+
+    // Fisher-Yates com below(), mais barato que std::shuffle e igual em qualquer biblioteca padrão
+    template<typename It>
+    void shuffle(It first, It last) {
+        for (auto i = last - first; i > 1; --i) {
+            swap(first[i - 1], first[below((uint32_t) i)]);
+        }
+    }
+
+    // Estado em texto, para os checkpoints (CheckpointBuffer::putRng)
+    friend ostream &operator<<(ostream &out, const RandomStream &rng) {
+        return out << rng.state[0] << ' ' << rng.state[1] << ' ' << rng.state[2] << ' ' << rng.state[3];
+    }
+
+    friend istream &operator>>(istream &in, RandomStream &rng) {
+        return in >> rng.state[0] >> rng.state[1] >> rng.state[2] >> rng.state[3];
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    void applyJump(const uint64_t *polynomial) {
+        uint64_t jumped[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; i++) {
+            for (int b = 0; b < 64; b++) {
+                if (polynomial[i] & (1ULL << b)) {
+                    for (int k = 0; k < 4; k++) jumped[k] ^= state[k];
+                }
+                (*this)();
+            }
+        }
+        for (int k = 0; k < 4; k++) state[k] = jumped[k];
+    }
+};
+
+// Semente de 64 bits do random_device, para execuções sem --seed
+inline uint64_t randomSeed() {
+    random_device rd;
+    return ((uint64_t) rd() << 32) ^ rd();
+}
+
+// Fluxo de uma execução: a semente base avançada por longJump() uma vez por replicação, de modo
+// que replicações da mesma semente nunca se sobrepõem
+inline RandomStream replicationStream(uint64_t seedValue, int replication) {
+    RandomStream rng(seedValue);
+    for (int r = 0; r < replication; r++) rng.longJump();
+    return rng;
+}
+
+#endif // RANDOM_STREAM_H
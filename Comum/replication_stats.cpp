@@ -0,0 +1,76 @@
+#include "replication_stats.h"
+#include <cmath>
+#include <iomanip>
+
+ReplicationSummary summarizeReplications(const vector<ReplicationRun> &runs) {
+    ReplicationSummary summary = {};
+    summary.runs = (int) runs.size();
+    if (runs.empty()) return summary;
+
+    vector<double> fitness;
+    double sumTime = 0.0;
+    for (const ReplicationRun &run: runs) {
+        fitness.push_back(run.finalFitness);
+        sumTime += run.executionTimeMs;
+    }
+    sort(fitness.begin(), fitness.end());
+
+    int n = summary.runs;
+    summary.bestFitness = fitness.front();
+    summary.worstFitness = fitness.back();
+    summary.medianFitness = (n % 2 == 1) ? fitness[n / 2] : 0.5 * (fitness[n / 2 - 1] + fitness[n / 2]);
+
+    double sum = 0.0;
+    for (double f: fitness) sum += f;
+    summary.meanFitness = sum / n;
+
+    double sumSqDiff = 0.0;
+    for (double f: fitness) sumSqDiff += (f - summary.meanFitness) * (f - summary.meanFitness);
+    summary.stdDev = (n > 1) ? sqrt(sumSqDiff / (n - 1)) : 0.0;
+
+    summary.meanExecutionTimeMs = sumTime / n;
+
+    // Primeiro instante em que cada execução atinge a média; uma melhoria fora do histórico
+    // (ex.: busca local depois da última geração) conta no fim da execução
+    double target = summary.meanFitness + 1e-9;
+    double sumReach = 0.0;
+    for (const ReplicationRun &run: runs) {
+        if (run.finalFitness > target) continue;
+
+        double reachMs = run.executionTimeMs;
+        for (const auto &point: run.bestCurve) {
+            if (point.second <= target) {
+                reachMs = point.first * 1000.0;
+                break;
+            }
+        }
+        sumReach += reachMs;
+        summary.runsReachingMean++;
+    }
+    summary.timeToMeanMs = summary.runsReachingMean > 0 ? sumReach / summary.runsReachingMean : 0.0;
+
+    return summary;
+}
+
+void writeReplicationHeader(ostream &out) {
+    out << "Instance,Jobs,Stages,Runs,BestFitness,MeanFitness,MedianFitness,StdDev,WorstFitness,"
+        << "MeanExecutionTime_ms,TimeToMean_ms,RunsReachingMean,Config\n";
+}
+
+void writeReplicationRow(ostream &out, const string &instance, int jobs, int stages,
+                         const ReplicationSummary &summary, const string &config) {
+    out << instance << ","
+        << jobs << ","
+        << stages << ","
+        << summary.runs << ","
+        << fixed << setprecision(4)
+        << summary.bestFitness << ","
+        << summary.meanFitness << ","
+        << summary.medianFitness << ","
+        << summary.stdDev << ","
+        << summary.worstFitness << ","
+        << summary.meanExecutionTimeMs << ","
+        << summary.timeToMeanMs << ","
+        << summary.runsReachingMean << ","
+        << config << "\n";
+}
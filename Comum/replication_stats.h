@@ -0,0 +1,54 @@
+#ifndef REPLICATION_STATS_H
+#define REPLICATION_STATS_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <utility>
+#include <algorithm>
+
+using namespace std;
+
+// ===== ESTATÍSTICAS ENTRE REPLICAÇÕES =====
+// Com --replications R cada instância é resolvida R vezes com sementes independentes; o
+// resumo compara as execuções entre si, e não as gerações de uma única execução.
+
+// Uma execução: fitness final, tempo total e a curva (segundos, melhor fitness até ali)
+struct ReplicationRun {
+    double finalFitness;
+    double executionTimeMs;
+    vector<pair<double, double>> bestCurve;
+};
+
+struct ReplicationSummary {
+    int runs;
+    double bestFitness;
+    double meanFitness;
+    double medianFitness;
+    double stdDev;         // Amostral (n - 1) entre as execuções
+    double worstFitness;
+    double meanExecutionTimeMs;
+    double timeToMeanMs;   // Tempo médio até o melhor fitness ficar <= a média das execuções
+    int runsReachingMean;  // Execuções que chegaram à média (entram em timeToMeanMs)
+};
+
+// Curva do melhor fitness acumulado a partir do histórico de gerações (GA ou PSO)
+template<typename Stats>
+vector<pair<double, double>> bestFitnessCurve(const vector<Stats> &history) {
+    vector<pair<double, double>> curve;
+    curve.reserve(history.size());
+    for (const Stats &stats: history) {
+        double best = curve.empty() ? stats.bestFitness : min(curve.back().second, stats.bestFitness);
+        curve.emplace_back(stats.elapsedTime, best);
+    }
+    return curve;
+}
+
+ReplicationSummary summarizeReplications(const vector<ReplicationRun> &runs);
+
+void writeReplicationHeader(ostream &out);
+
+void writeReplicationRow(ostream &out, const string &instance, int jobs, int stages,
+                         const ReplicationSummary &summary, const string &config);
+
+#endif // REPLICATION_STATS_H
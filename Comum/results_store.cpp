@@ -0,0 +1,209 @@
+#include "results_store.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const int NUM_FIELDS = 13; // 12 campos + checksum
+
+static uint64_t fnv1a(const string &text) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c: text) {
+        hash ^= c;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static string toHex(uint64_t value) {
+    ostringstream out;
+    out << hex << setw(16) << setfill('0') << value;
+    return out.str();
+}
+
+// Tabulações e quebras de linha separam campos e registros
+static string sanitize(string text) {
+    for (char &c: text) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return text;
+}
+
+static string encodeCurve(const vector<pair<double, double>> &curve) {
+    // Só os pontos em que o melhor fitness melhora: é o que summarizeReplications consulta
+    ostringstream out;
+    out << setprecision(17);
+    bool first = true;
+    for (size_t i = 0; i < curve.size(); i++) {
+        if (i > 0 && curve[i].second >= curve[i - 1].second) continue;
+        if (!first) out << ',';
+        out << curve[i].first << ':' << curve[i].second;
+        first = false;
+    }
+    return out.str();
+}
+
+static vector<pair<double, double>> decodeCurve(const string &text) {
+    vector<pair<double, double>> curve;
+    istringstream in(text);
+    string point;
+    while (getline(in, point, ',')) {
+        size_t colon = point.find(':');
+        if (colon == string::npos) continue;
+        curve.emplace_back(stod(point.substr(0, colon)), stod(point.substr(colon + 1)));
+    }
+    return curve;
+}
+
+static void syncToDisk(FILE *file) {
+    fflush(file);
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+uint64_t hashConfig(const string &canonicalConfig) {
+    return fnv1a(canonicalConfig);
+}
+
+string ResultKey::str() const {
+    return algorithm + '\t' + instance + '\t' + toHex(configHash) + '\t' + to_string(seed) + '\t' +
+           to_string(replication);
+}
+
+ResultsStore::ResultsStore(const string &path) : path(path), file(nullptr), discarded(0) {
+    load();
+
+    // Uma linha truncada no fim não pode grudar no próximo registro
+    bool needsNewline = false;
+    bool isNew = true;
+    {
+        ifstream existing(path, ios::binary | ios::ate);
+        if (existing.is_open() && existing.tellg() > 0) {
+            isNew = false;
+            existing.seekg(-1, ios::end);
+            needsNewline = existing.get() != '\n';
+        }
+    }
+
+    file = fopen(path.c_str(), "ab");
+    if (!file) {
+        cerr << "AVISO: Nao foi possivel abrir o armazem de resultados " << path << endl;
+        return;
+    }
+    // Sem buffer: cada registro sai numa única escrita no fim do arquivo
+    setvbuf(file, nullptr, _IONBF, 0);
+    if (isNew) fputs("# algorithm\tinstance\tconfig_hash\tseed\treplication\tjobs\tstages\tfinal_fitness"
+                     "\ttime_ms\tbest_curve\tconfig\tsummary_row\tchecksum\n", file);
+    if (needsNewline) fputc('\n', file);
+    syncToDisk(file);
+}
+
+ResultsStore::~ResultsStore() {
+    if (file) fclose(file);
+}
+
+void ResultsStore::load() {
+    ifstream in(path, ios::binary);
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        vector<string> fields;
+        size_t start = 0;
+        for (size_t tab = line.find('\t'); tab != string::npos; tab = line.find('\t', start)) {
+            fields.push_back(line.substr(start, tab - start));
+            start = tab + 1;
+        }
+        fields.push_back(line.substr(start));
+
+        size_t lastTab = line.rfind('\t');
+        if ((int) fields.size() != NUM_FIELDS || toHex(fnv1a(line.substr(0, lastTab))) != fields.back()) {
+            discarded++;
+            continue;
+        }
+
+        try {
+            StoredResult result;
+            result.key.algorithm = fields[0];
+            result.key.instance = fields[1];
+            result.key.configHash = stoull(fields[2], nullptr, 16);
+            result.key.seed = stoull(fields[3]);
+            result.key.replication = stoi(fields[4]);
+            result.jobs = stoi(fields[5]);
+            result.stages = stoi(fields[6]);
+            result.run.finalFitness = stod(fields[7]);
+            result.run.executionTimeMs = stod(fields[8]);
+            result.run.bestCurve = decodeCurve(fields[9]);
+            result.config = fields[10];
+            result.summaryRow = fields[11];
+            insert(result);
+        } catch (const exception &) {
+            discarded++;
+        }
+    }
+}
+
+void ResultsStore::insert(const StoredResult &result) {
+    string key = result.key.str();
+    auto it = index.find(key);
+    if (it != index.end()) {
+        records[it->second] = result;
+    } else {
+        index[key] = records.size();
+        records.push_back(result);
+    }
+}
+
+size_t ResultsStore::size() const {
+    lock_guard<mutex> lock(storeMutex);
+    return records.size();
+}
+
+const StoredResult *ResultsStore::find(const ResultKey &key) const {
+    lock_guard<mutex> lock(storeMutex);
+    auto it = index.find(key.str());
+    return (it != index.end()) ? &records[it->second] : nullptr;
+}
+
+bool ResultsStore::latestSeed(const string &algorithm, uint64_t configHash, uint64_t &seed) const {
+    lock_guard<mutex> lock(storeMutex);
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+        if (it->key.algorithm == algorithm && it->key.configHash == configHash) {
+            seed = it->key.seed;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ResultsStore::append(const StoredResult &result) {
+    ostringstream line;
+    line << setprecision(17)
+         << result.key.str() << '\t'
+         << result.jobs << '\t'
+         << result.stages << '\t'
+         << result.run.finalFitness << '\t'
+         << result.run.executionTimeMs << '\t'
+         << encodeCurve(result.run.bestCurve) << '\t'
+         << sanitize(result.config) << '\t'
+         << sanitize(result.summaryRow);
+    string content = line.str();
+    string record = content + '\t' + toHex(fnv1a(content)) + '\n';
+
+    lock_guard<mutex> lock(storeMutex);
+    insert(result);
+    if (!file) return false;
+    bool ok = fwrite(record.data(), 1, record.size(), file) == record.size();
+    syncToDisk(file);
+    return ok;
+}
@@ -0,0 +1,83 @@
+#ifndef RESULTS_STORE_H
+#define RESULTS_STORE_H
+
+#include "replication_stats.h"
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdio>
+#include <cstdint>
+
+using namespace std;
+
+// ===== ARMAZÉM DE RESULTADOS =====
+// Arquivo de texto só de acréscimo no diretório de saída: cada execução concluída vira uma linha,
+// gravada e sincronizada com o disco assim que termina. Um lote interrompido perde no máximo as
+// execuções em andamento, e a nova execução do mesmo comando pula o que já está no armazém. Os
+// resumos CSV passam a ser uma vista dele, montada no fim do lote.
+// Linha: campos separados por tabulação terminados por um checksum FNV-1a; uma linha truncada
+// (queda no meio da gravação) ou corrompida é ignorada na leitura. Se a mesma chave aparece mais de
+// uma vez (--recompute), vale a última.
+
+// Identifica um resultado: mesma chave = mesma execução, que não precisa ser refeita
+struct ResultKey {
+    string algorithm;    // "GA", "PSO", "RKPSO", "PT"...
+    string instance;     // Arquivo da instância
+    uint64_t configHash; // hashConfig() dos parâmetros que afetam o resultado (sem a semente)
+    uint64_t seed;       // Semente base (--seed)
+    int replication;     // 1..R
+
+    string str() const;
+};
+
+struct StoredResult {
+    ResultKey key;
+    int jobs;
+    int stages;
+    string config;     // Configuração legível (coluna de configuração dos resumos)
+    string summaryRow; // Linha pronta do summary_<GA|PSO>_*.csv
+    ReplicationRun run;
+};
+
+// FNV-1a de 64 bits da descrição canônica da configuração
+uint64_t hashConfig(const string &canonicalConfig);
+
+class ResultsStore {
+public:
+    // Lê o armazém existente (se houver) e o mantém aberto para acréscimos
+    explicit ResultsStore(const string &path);
+
+    ~ResultsStore();
+
+    ResultsStore(const ResultsStore &) = delete;
+    ResultsStore &operator=(const ResultsStore &) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+    const string &getPath() const { return path; }
+    size_t size() const;
+    int discardedLines() const { return discarded; }
+
+    // nullptr se a chave não estiver no armazém; o ponteiro continua válido após novos acréscimos
+    const StoredResult *find(const ResultKey &key) const;
+
+    // Semente do resultado mais recente com este algoritmo e configuração (retomada sem --seed)
+    bool latestSeed(const string &algorithm, uint64_t configHash, uint64_t &seed) const;
+
+    // Grava o resultado no fim do arquivo e sincroniza com o disco; seguro entre threads
+    bool append(const StoredResult &result);
+
+private:
+    string path;
+    FILE *file;
+    int discarded;
+    mutable mutex storeMutex;
+    deque<StoredResult> records; // Ordem do arquivo; deque mantém os ponteiros de find() válidos
+    unordered_map<string, size_t> index; // ResultKey::str() -> posição em records
+
+    void load();
+
+    void insert(const StoredResult &result);
+};
+
+#endif // RESULTS_STORE_H
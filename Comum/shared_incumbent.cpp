@@ -0,0 +1,102 @@
+#include "shared_incumbent.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+// Crédito mínimo de cada membro: sem melhorias recentes, a divisão tende a ficar igual
+static const double PRIOR_CREDIT = 1e-3;
+
+SharedIncumbent::SharedIncumbent(int numMembers, int totalThreads, double halfLifeSeconds)
+    : totalThreads(max(1, totalThreads)), halfLife(max(1e-3, halfLifeSeconds)),
+      lastDecay(chrono::steady_clock::now()), incumbentFitness(numeric_limits<double>::max()),
+      incumbentOwner(-1), version(0), seenVersion(numMembers, 0), credit(numMembers, 0.0),
+      improvementCount(numMembers, 0), active(numMembers, 1) {
+    for (int m = 0; m < numMembers; m++) {
+        ports.push_back(make_unique<Port>(this, m));
+        limits.push_back(make_unique<atomic<int>>(1));
+    }
+    lock_guard<mutex> lock(incumbentMutex);
+    rebalance();
+}
+
+void SharedIncumbent::offer(int member, const vector<int> &permutation, double fitness) {
+    lock_guard<mutex> lock(incumbentMutex);
+
+    auto now = chrono::steady_clock::now();
+    double factor = pow(0.5, chrono::duration<double>(now - lastDecay).count() / halfLife);
+    for (double &c: credit) c *= factor;
+    lastDecay = now;
+
+    if (fitness < incumbentFitness) {
+        // A primeira publicação não melhora nada: só define o ponto de partida
+        if (incumbentOwner >= 0 && incumbentFitness > 0.0) {
+            credit[member] += (incumbentFitness - fitness) / incumbentFitness;
+            improvementCount[member]++;
+        }
+        incumbent = permutation;
+        incumbentFitness = fitness;
+        incumbentOwner = member;
+        version++;
+        seenVersion[member] = version; // Quem publicou já tem esta solução
+    }
+    rebalance();
+}
+
+bool SharedIncumbent::take(int member, vector<int> &permutation, double &fitness) {
+    lock_guard<mutex> lock(incumbentMutex);
+    if (version == seenVersion[member]) return false;
+    seenVersion[member] = version;
+    if (incumbentOwner == member) return false;
+    permutation = incumbent;
+    fitness = incumbentFitness;
+    return true;
+}
+
+void SharedIncumbent::retire(int member) {
+    lock_guard<mutex> lock(incumbentMutex);
+    active[member] = 0;
+    rebalance();
+}
+
+bool SharedIncumbent::best(vector<int> &permutation, double &fitness) const {
+    lock_guard<mutex> lock(incumbentMutex);
+    if (incumbentOwner < 0) return false;
+    permutation = incumbent;
+    fitness = incumbentFitness;
+    return true;
+}
+
+int SharedIncumbent::improvements(int member) const {
+    lock_guard<mutex> lock(incumbentMutex);
+    return improvementCount[member];
+}
+
+void SharedIncumbent::rebalance() {
+    vector<int> members;
+    for (size_t m = 0; m < active.size(); m++) {
+        if (active[m]) members.push_back((int) m);
+        else limits[m]->store(1);
+    }
+    if (members.empty()) return;
+
+    // Uma thread para cada membro ativo; o restante é dividido pelos créditos (maiores restos)
+    int spare = max(0, totalThreads - (int) members.size());
+    double totalCredit = 0.0;
+    for (int m: members) totalCredit += credit[m] + PRIOR_CREDIT;
+
+    vector<int> alloc(members.size(), 1);
+    vector<pair<double, int>> remainders;
+    int assigned = 0;
+    for (size_t i = 0; i < members.size(); i++) {
+        double exact = spare * (credit[members[i]] + PRIOR_CREDIT) / totalCredit;
+        int whole = (int) floor(exact);
+        alloc[i] += whole;
+        assigned += whole;
+        remainders.push_back({exact - whole, (int) i});
+    }
+    sort(remainders.begin(), remainders.end(), greater<pair<double, int>>());
+    for (int r = 0; r < spare - assigned; r++) alloc[remainders[r].second]++;
+
+    for (size_t i = 0; i < members.size(); i++) limits[members[i]]->store(alloc[i]);
+}
@@ -0,0 +1,83 @@
+#ifndef SHARED_INCUMBENT_H
+#define SHARED_INCUMBENT_H
+
+#include "elite_port.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+// ===== INCUMBENTE COMPARTILHADO (PORTFÓLIO) =====
+// Solvers diferentes na mesma instância e no mesmo processo publicam o seu melhor pela porta de
+// cada um; quem recebe ganha o incumbente sempre que ele veio de outro membro e ainda não foi
+// visto. Cada melhoria credita o membro que a trouxe pela redução relativa do fitness, com
+// decaimento exponencial: a divisão das threads entre os membros acompanha quem está melhorando
+// agora, e volta a ser igual quando ninguém melhora por algumas meias-vidas.
+class SharedIncumbent {
+public:
+    SharedIncumbent(int numMembers, int totalThreads, double halfLifeSeconds);
+
+    SharedIncumbent(const SharedIncumbent &) = delete;
+    SharedIncumbent &operator=(const SharedIncumbent &) = delete;
+
+    ElitePort &port(int member) { return *ports[member]; }
+
+    // Teto de threads do membro, para ThreadPool::setLimit
+    const atomic<int> *threadLimit(int member) const { return limits[member].get(); }
+
+    int threadsOf(int member) const { return limits[member]->load(); }
+
+    // O membro terminou: as threads dele passam para os que continuam
+    void retire(int member);
+
+    // Melhor permutação publicada até agora (IDs a partir de 1); false se ninguém publicou
+    bool best(vector<int> &permutation, double &fitness) const;
+
+    // Quantas vezes o membro melhorou o incumbente
+    int improvements(int member) const;
+
+private:
+    struct Port : ElitePort {
+        SharedIncumbent *owner;
+        int member;
+
+        Port(SharedIncumbent *owner, int member) : owner(owner), member(member) {}
+
+        void publish(const vector<int> &permutation, double fitness) override {
+            owner->offer(member, permutation, fitness);
+        }
+
+        bool receive(vector<int> &permutation, double &fitness) override {
+            return owner->take(member, permutation, fitness);
+        }
+    };
+
+    int totalThreads;
+    double halfLife;
+    chrono::steady_clock::time_point lastDecay;
+
+    mutable mutex incumbentMutex;
+    vector<int> incumbent;
+    double incumbentFitness;
+    int incumbentOwner;
+    long long version;
+
+    vector<unique_ptr<Port>> ports;
+    vector<unique_ptr<atomic<int>>> limits;
+    vector<long long> seenVersion; // Última versão do incumbente entregue a cada membro
+    vector<double> credit;
+    vector<int> improvementCount;
+    vector<char> active;
+
+    void offer(int member, const vector<int> &permutation, double fitness);
+
+    bool take(int member, vector<int> &permutation, double &fitness);
+
+    // Recalcula os tetos de threads pelos créditos; chamado com incumbentMutex travado
+    void rebalance();
+};
+
+#endif // SHARED_INCUMBENT_H
@@ -0,0 +1,191 @@
+#include "task_runtime.h"
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    int configuredThreads = 0;
+    bool configuredPin = false;
+
+    // Índice da thread do runtime que está executando; -1 fora do runtime
+    thread_local int currentWorker = -1;
+
+#if defined(__linux__)
+    cpu_set_t processAffinity;
+    bool processAffinityKnown = false;
+
+    void saveProcessAffinity() {
+        if (processAffinityKnown) return;
+        processAffinityKnown = sched_getaffinity(0, sizeof(processAffinity), &processAffinity) == 0;
+    }
+#endif
+
+    // Núcleo slot (módulo os permitidos ao processo); fora do Linux a fixação é ignorada
+    void pinCurrentThread(int slot) {
+#if defined(__linux__)
+        if (!processAffinityKnown) return;
+        vector<int> allowed;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &processAffinity)) allowed.push_back(cpu);
+        }
+        if (allowed.empty()) return;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(allowed[slot % allowed.size()], &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void) slot;
+#endif
+    }
+}
+
+void TaskRuntime::configure(int numThreads, bool pinThreads) {
+    configuredThreads = numThreads;
+    configuredPin = pinThreads;
+}
+
+TaskRuntime &TaskRuntime::instance() {
+    static TaskRuntime runtime(configuredThreads, configuredPin);
+    return runtime;
+}
+
+TaskRuntime::TaskRuntime(int numThreads, bool pinThreads)
+    : queuedFine(0), queuedCoarse(0), stopping(false) {
+    if (numThreads <= 0) {
+        numThreads = max(1, (int) thread::hardware_concurrency());
+    }
+#if defined(__linux__)
+    if (pinThreads) saveProcessAffinity();
+#endif
+
+    // Quem chama wait() é a thread extra: o runtime cria numThreads - 1
+    for (int w = 0; w < numThreads - 1; w++) {
+        localQueues.emplace_back(new TaskQueue());
+    }
+    for (int w = 0; w < numThreads - 1; w++) {
+        workers.emplace_back(&TaskRuntime::workerLoop, this, w, pinThreads);
+    }
+}
+
+TaskRuntime::~TaskRuntime() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCv.notify_all();
+    for (auto &t: workers) {
+        t.join();
+    }
+}
+
+void TaskRuntime::spawn(TaskGroup &group, function<void()> task, bool coarse) {
+    group.pending.fetch_add(1);
+
+    TaskQueue &queue = coarse ? coarseQueue : (currentWorker >= 0 ? *localQueues[currentWorker] : sharedQueue);
+    {
+        lock_guard<mutex> lock(queue.mtx);
+        queue.tasks.push_back({move(task), &group});
+        (coarse ? queuedCoarse : queuedFine).fetch_add(1);
+    }
+
+    // Passar pelo sleepMutex evita perder o aviso para quem acabou de testar as filas
+    { lock_guard<mutex> lock(sleepMutex); }
+    if (coarse) {
+        sleepCv.notify_all(); // Quem espera um parallelFor não aceita tarefa grossa
+    } else {
+        sleepCv.notify_one();
+    }
+}
+
+bool TaskRuntime::pop(TaskQueue &queue, bool fromBack, atomic<int> &counter, Task &task) {
+    lock_guard<mutex> lock(queue.mtx);
+    if (queue.tasks.empty()) return false;
+
+    if (fromBack) {
+        task = move(queue.tasks.back());
+        queue.tasks.pop_back();
+    } else {
+        task = move(queue.tasks.front());
+        queue.tasks.pop_front();
+    }
+    counter.fetch_sub(1);
+    return true;
+}
+
+void TaskRuntime::execute(Task &task) {
+    task.run();
+
+    // Depois de zerar o grupo ele pode ser destruído por quem espera; só o runtime é tocado
+    if (task.group->pending.fetch_sub(1) == 1) {
+        lock_guard<mutex> lock(sleepMutex);
+        sleepCv.notify_all();
+    }
+}
+
+bool TaskRuntime::runOne(bool allowCoarse) {
+    Task task;
+    int self = currentWorker;
+
+    // Própria deque pelo fim (o pedaço mais recente, ainda quente no cache)
+    if (self >= 0 && pop(*localQueues[self], true, queuedFine, task)) {
+        execute(task);
+        return true;
+    }
+    if (pop(sharedQueue, false, queuedFine, task)) {
+        execute(task);
+        return true;
+    }
+
+    // Roubo pelo começo das outras deques, a partir da vizinha
+    int numQueues = (int) localQueues.size();
+    for (int k = 1; k <= numQueues; k++) {
+        int victim = (self + k + numQueues) % numQueues;
+        if (victim == self) continue;
+        if (pop(*localQueues[victim], false, queuedFine, task)) {
+            execute(task);
+            return true;
+        }
+    }
+
+    if (allowCoarse && pop(coarseQueue, false, queuedCoarse, task)) {
+        execute(task);
+        return true;
+    }
+    return false;
+}
+
+void TaskRuntime::workerLoop(int worker, bool pin) {
+    currentWorker = worker;
+    if (pin) pinCurrentThread(worker + 1); // O núcleo do slot 0 fica para a thread principal
+
+    while (true) {
+        if (runOne(true)) continue;
+
+        unique_lock<mutex> lock(sleepMutex);
+        sleepCv.wait(lock, [&] { return stopping || queuedFine.load() > 0 || queuedCoarse.load() > 0; });
+        if (stopping && queuedFine.load() == 0 && queuedCoarse.load() == 0) return;
+    }
+}
+
+void TaskRuntime::wait(TaskGroup &group, bool allowCoarse) {
+    while (group.pending.load() > 0) {
+        if (runOne(allowCoarse)) continue;
+
+        unique_lock<mutex> lock(sleepMutex);
+        sleepCv.wait(lock, [&] {
+            return group.pending.load() == 0 || queuedFine.load() > 0 ||
+                   (allowCoarse && queuedCoarse.load() > 0);
+        });
+    }
+}
+
+void resetThreadAffinity() {
+#if defined(__linux__)
+    if (!configuredPin || !processAffinityKnown) return;
+    pthread_setaffinity_np(pthread_self(), sizeof(processAffinity), &processAffinity);
+#endif
+}
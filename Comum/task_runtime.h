@@ -0,0 +1,91 @@
+#ifndef TASK_RUNTIME_H
+#define TASK_RUNTIME_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+using namespace std;
+
+// ===== RUNTIME DE TAREFAS COM ROUBO DE TRABALHO =====
+// Um único conjunto de threads por processo, compartilhado pelo lote de instâncias (runBatch)
+// e pelos laços paralelos dos solvers (ThreadPool::parallelFor). Há dois tipos de tarefa:
+//  - grossas: uma instância/replicação inteira, numa fila global FIFO;
+//  - finas: pedaços de um parallelFor, na deque da thread do runtime que as criou (ou numa
+//    fila compartilhada, se quem criou é uma thread de fora). O dono consome a própria deque
+//    pelo fim; threads ociosas roubam pelo começo.
+// Quem espera um grupo executa tarefas enquanto espera. Com todas as threads ocupadas, cada
+// instância acaba executando os próprios pedaços, sem threads extras; quando uma instância
+// pequena termina, a thread dela passa a roubar pedaços das instâncias grandes.
+
+// Tarefas pendentes de um conjunto de spawn(); wait() volta quando chega a zero
+struct TaskGroup {
+    atomic<int> pending{0};
+};
+
+class TaskRuntime {
+public:
+    // Total de threads (contando a que chama wait) e fixação das threads do runtime em núcleos.
+    // Só tem efeito antes do primeiro uso; numThreads <= 0 usa hardware_concurrency().
+    static void configure(int numThreads, bool pinThreads);
+
+    static TaskRuntime &instance();
+
+    ~TaskRuntime();
+
+    TaskRuntime(const TaskRuntime &) = delete;
+
+    TaskRuntime &operator=(const TaskRuntime &) = delete;
+
+    int size() const { return (int) workers.size() + 1; }
+
+    void spawn(TaskGroup &group, function<void()> task, bool coarse = false);
+
+    // Bloqueia até o grupo terminar, executando tarefas enquanto isso. Tarefas grossas só com
+    // allowCoarse: quem espera um parallelFor não deve assumir uma instância inteira.
+    void wait(TaskGroup &group, bool allowCoarse);
+
+private:
+    struct Task {
+        function<void()> run;
+        TaskGroup *group;
+    };
+
+    struct TaskQueue {
+        mutex mtx;
+        deque<Task> tasks;
+    };
+
+    TaskRuntime(int numThreads, bool pinThreads);
+
+    vector<thread> workers;
+    vector<unique_ptr<TaskQueue>> localQueues; // Uma por thread do runtime
+    TaskQueue sharedQueue;                     // Tarefas finas criadas fora do runtime
+    TaskQueue coarseQueue;
+
+    mutex sleepMutex;
+    condition_variable sleepCv;
+    atomic<int> queuedFine;
+    atomic<int> queuedCoarse;
+    bool stopping;
+
+    void workerLoop(int worker, bool pin);
+
+    bool runOne(bool allowCoarse);
+
+    bool pop(TaskQueue &queue, bool fromBack, atomic<int> &counter, Task &task);
+
+    void execute(Task &task);
+};
+
+// Com --pin-threads as threads do runtime ficam presas a um núcleo, e no Linux threads criadas
+// por elas herdam essa afinidade. Threads dedicadas (ilhas, steady-state, busca local) chamam
+// isto no início para voltar a usar todos os núcleos do processo.
+void resetThreadAffinity();
+
+#endif // TASK_RUNTIME_H
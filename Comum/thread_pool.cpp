@@ -0,0 +1,37 @@
+#include "thread_pool.h"
+#include "task_runtime.h"
+#include <atomic>
+#include <algorithm>
+
+ThreadPool::ThreadPool(int numThreads) : numWorkers(max(1, numThreads)), activeLimit(nullptr) {
+}
+
+void ThreadPool::parallelFor(int count, const function<void(int, int)> &body) {
+    int active = activeLimit ? max(1, min(numWorkers, activeLimit->load(memory_order_relaxed))) : numWorkers;
+    if (active == 1 || count <= 1) {
+        for (int i = 0; i < count; i++) {
+            body(i, 0);
+        }
+        return;
+    }
+
+    // Distribuição dinâmica: cada worker pega o próximo índice livre. Um pedaço que só começa
+    // depois de todos os índices distribuídos termina sem chamar body.
+    atomic<int> nextIndex(0);
+    atomic<int> nextWorker(1);
+    auto runChunk = [&](int worker) {
+        for (int i = nextIndex.fetch_add(1); i < count; i = nextIndex.fetch_add(1)) {
+            body(i, worker);
+        }
+    };
+
+    TaskRuntime &runtime = TaskRuntime::instance();
+    TaskGroup group;
+    int numHelpers = min(active, count) - 1;
+    for (int h = 0; h < numHelpers; h++) {
+        runtime.spawn(group, [&] { runChunk(nextWorker.fetch_add(1)); });
+    }
+
+    runChunk(0);
+    runtime.wait(group, false);
+}
@@ -0,0 +1,37 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <atomic>
+
+using namespace std;
+
+// Laços paralelos dentro de uma geração, executados no runtime de tarefas compartilhado
+// (task_runtime.h): o pool não cria threads próprias, só define quantos contextos de worker
+// (RNG, dados) um laço pode usar ao mesmo tempo. A thread que chama parallelFor participa
+// como worker 0; os demais workers são tarefas finas que threads ociosas do runtime roubam.
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads);
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int size() const { return numWorkers; }
+
+    // Teto de workers lido a cada parallelFor (nullptr = size()): o portfólio muda a divisão das
+    // threads entre os solvers durante a execução, sem recriar pools
+    void setLimit(const atomic<int> *limit) { activeLimit = limit; }
+
+    // Executa body(index, worker) para index em [0, count); bloqueia até terminar.
+    // worker está em [0, size()) e identifica o contexto (RNG, dados) a ser usado; dois
+    // pedaços ao mesmo tempo nunca recebem o mesmo worker.
+    void parallelFor(int count, const function<void(int, int)> &body);
+
+private:
+    int numWorkers;
+    const atomic<int> *activeLimit;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,193 @@
+#ifndef CROSSOVER_KERNELS_H
+#define CROSSOVER_KERNELS_H
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+// ===== KERNELS DE CROSSOVER =====
+// Versões lineares dos crossovers do GA sobre cromossomos 0-based (genes 0..n-1).
+// Pertinência é testada por marcadores indexados pelo gene em vez de find/set/map, e os
+// filhos são escritos em buffers já alocados. O RNG é um RandomStream (random_stream.h): os
+// cortes vêm de uniformInt e a máscara do OBX de 64 bits por sorteio.
+
+// Marcadores reutilizados entre chamadas (um conjunto por thread)
+struct CrossoverMarks
+{
+    vector<char> used1;
+    vector<char> used2;
+    vector<char> mask;
+    vector<int> segment1; // segment1[gene] = posição do gene no segmento de p2, ou -1
+    vector<int> segment2; // segment2[gene] = posição do gene no segmento de p1, ou -1
+
+    void clearUsed(int n)
+    {
+        used1.assign(n, 0);
+        used2.assign(n, 0);
+    }
+
+    void clearSegments(int n)
+    {
+        segment1.assign(n, -1);
+        segment2.assign(n, -1);
+    }
+};
+
+// OBX: máscara uniforme copia genes dos pais; o resto vem do outro pai, na ordem
+template<typename Gene, typename Rng>
+void orderBasedKernel(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, int n, Rng &rng,
+                      CrossoverMarks &marks)
+{
+    marks.clearUsed(n);
+    vector<char> &used1 = marks.used1;
+    vector<char> &used2 = marks.used2;
+
+    // A máscara é sorteada inteira antes de copiar, um bit por gene
+    vector<char> &mask = marks.mask;
+    mask.resize(n);
+    uint64_t bits = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        if ((i & 63) == 0) bits = rng();
+        mask[i] = (bits >> (i & 63)) & 1;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (mask[i])
+        {
+            child1[i] = p1[i];
+            child2[i] = p2[i];
+            used1[p1[i]] = 1;
+            used2[p2[i]] = 1;
+        }
+    }
+
+    int pos1 = 0, pos2 = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        if (!mask[i])
+        {
+            while (used1[p2[pos1]]) pos1++;
+            child1[i] = p2[pos1];
+            used1[p2[pos1++]] = 1;
+
+            while (used2[p1[pos2]]) pos2++;
+            child2[i] = p1[pos2];
+            used2[p1[pos2++]] = 1;
+        }
+    }
+}
+
+// PMX: troca o segmento [cut1, cut2] e resolve conflitos fora dele seguindo o mapeamento
+template<typename Gene, typename Rng>
+void partialMappedKernel(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, int n, Rng &rng,
+                         CrossoverMarks &marks)
+{
+    int cut1 = rng.uniformInt(0, n - 1);
+    int cut2 = rng.uniformInt(0, n - 1);
+    if (cut1 > cut2) swap(cut1, cut2);
+
+    marks.clearSegments(n);
+    vector<int> &segment1 = marks.segment1;
+    vector<int> &segment2 = marks.segment2;
+    for (int i = cut1; i <= cut2; ++i)
+    {
+        segment1[p2[i]] = i;
+        segment2[p1[i]] = i;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (i >= cut1 && i <= cut2)
+        {
+            child1[i] = p2[i];
+            child2[i] = p1[i];
+            continue;
+        }
+
+        // Gene repetido no segmento: seguir p2[k] -> p1[k] até sair dele
+        Gene gene1 = p1[i];
+        while (segment1[gene1] != -1) gene1 = p1[segment1[gene1]];
+        child1[i] = gene1;
+
+        Gene gene2 = p2[i];
+        while (segment2[gene2] != -1) gene2 = p2[segment2[gene2]];
+        child2[i] = gene2;
+    }
+}
+
+// OPX: prefixo [0, cut) de um pai e o restante na ordem do outro
+template<typename Gene, typename Rng>
+void onePointOrderKernel(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, int n, Rng &rng,
+                         CrossoverMarks &marks)
+{
+    int cutPoint = rng.uniformInt(1, n - 1);
+
+    marks.clearUsed(n);
+    vector<char> &used1 = marks.used1;
+    vector<char> &used2 = marks.used2;
+
+    for (int i = 0; i < cutPoint; ++i)
+    {
+        child1[i] = p1[i];
+        child2[i] = p2[i];
+        used1[p1[i]] = 1;
+        used2[p2[i]] = 1;
+    }
+
+    int fill1 = cutPoint, fill2 = cutPoint;
+    for (int i = 0; i < n; ++i)
+    {
+        if (!used1[p2[i]]) child1[fill1++] = p2[i];
+        if (!used2[p1[i]]) child2[fill2++] = p1[i];
+    }
+}
+
+// TPX: segmento [cut1, cut2] de um pai e o restante do outro a partir de cut2 + 1, circular
+template<typename Gene, typename Rng>
+void twoPointOrderKernel(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, int n, Rng &rng,
+                         CrossoverMarks &marks)
+{
+    int cut1 = rng.uniformInt(0, n - 1);
+    int cut2 = rng.uniformInt(0, n - 1);
+    if (cut1 > cut2) swap(cut1, cut2);
+
+    marks.clearUsed(n);
+    vector<char> &used1 = marks.used1;
+    vector<char> &used2 = marks.used2;
+
+    for (int i = cut1; i <= cut2; ++i)
+    {
+        child1[i] = p1[i];
+        child2[i] = p2[i];
+        used1[p1[i]] = 1;
+        used2[p2[i]] = 1;
+    }
+
+    // Os genes que faltam são exatamente n - (cut2 - cut1 + 1), e as posições livres percorridas
+    // circularmente a partir de cut2 + 1 terminam em cut1 - 1: não há segmento a pular
+    int fill1 = (cut2 + 1) % n;
+    int fill2 = (cut2 + 1) % n;
+
+    for (int i = 0; i < n; ++i)
+    {
+        int idx = (cut2 + 1 + i) % n;
+
+        if (!used1[p2[idx]])
+        {
+            child1[fill1] = p2[idx];
+            fill1 = (fill1 + 1) % n;
+        }
+
+        if (!used2[p1[idx]])
+        {
+            child2[fill2] = p1[idx];
+            fill2 = (fill2 + 1) % n;
+        }
+    }
+}
+
+#endif
@@ -1,565 +1,727 @@
 #include "genetic_algorithm.h"
+#include "task_runtime.h"
 #include <algorithm>
 #include <numeric>
-
-GeneticAlgorithm::GeneticAlgorithm(const GAParameters &p, const ProblemData &data)
-    : params(p), problemData(data), currentGeneration(0), generationsWithoutImprovement(0) {
-    random_device rd;
-    rng.seed(rd());
+#include <climits>
+#include <iomanip>
+#include <fstream>
+
+template<typename Gene>
+GeneticAlgorithm<Gene>::GeneticAlgorithm(const GAParameters &p, const ProblemData &data)
+    : params(p), problemData(data), numGenes(data.numJobs), currentGeneration(0), generationsWithoutImprovement(0),
+      crossoverBandit({"OBX", "PMX", "SB2OX", "OPX", "TPX"}),
+      mutationBandit({"Insert", "Interchange", "Swap"}), lastCheckpointTime(0.0), resumedTime(0.0),
+      elitePort(nullptr), migrationInterval(0), migrantsAccepted(0), threadLimit(nullptr) {
+    setRandomStream(RandomStream(randomSeed()));
     history.clear();
 }
 
-void GeneticAlgorithm::initializePopulation() {
-    population.clear();
-    population.resize(params.populationSize);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::setRandomStream(const RandomStream &stream) {
+    rng = stream;
+    diversityMeter.seed(rng());
+}
 
-    vector<int> baseChromosome(problemData.numJobs);
-    iota(baseChromosome.begin(), baseChromosome.end(), 0);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::setElitePort(ElitePort *port, int interval) {
+    elitePort = port;
+    migrationInterval = max(1, interval);
+}
+
+template<typename Gene>
+void GeneticAlgorithm<Gene>::initializePopulation() {
+    population.resize(params.populationSize, numGenes);
 
     for (int i = 0; i < params.populationSize; ++i) {
-        vector<int> chromosome = baseChromosome;
-        shuffle(chromosome.begin(), chromosome.end(), rng);
-        population[i] = Individual(chromosome);
+        Gene *chromosome = population.row(i);
+        iota(chromosome, chromosome + numGenes, Gene(0));
+        rng.shuffle(chromosome, chromosome + numGenes);
     }
 }
 
-void GeneticAlgorithm::initializePopulationWithSeed(const vector<int> &seedChromosome) {
-    population.clear();
-    population.resize(params.populationSize);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::initializePopulationWithSeed(const vector<int> &seedChromosome) {
+    // Sem seed (run()) as linhas da matriz não teriam o tamanho do problema: população aleatória
+    if ((int) seedChromosome.size() != numGenes) {
+        initializePopulation();
+        return;
+    }
+
+    population.resize(params.populationSize, numGenes);
 
     // Primeiro indivíduo é a solução seed
-    population[0] = Individual(seedChromosome);
+    population.assignRow(0, seedChromosome);
 
     // 30% da população: pequenas mutações do seed
     int mutatedCount = params.populationSize * 3 / 10;
     for (int i = 1; i < mutatedCount; ++i) {
-        Individual mutated(seedChromosome);
+        population.assignRow(i, seedChromosome);
 
         // Aplicar múltiplas mutações
         int numMutations = 1 + (i % 5);
         for (int m = 0; m < numMutations; ++m) {
-            performMutation(mutated);
+            performMutation(population.row(i));
         }
-
-        population[i] = mutated;
     }
 
     // 70% da população: completamente aleatórios
-    vector<int> baseChromosome(problemData.numJobs);
-    iota(baseChromosome.begin(), baseChromosome.end(), 0);
-
     for (int i = mutatedCount; i < params.populationSize; ++i) {
-        vector<int> chromosome = baseChromosome;
-        shuffle(chromosome.begin(), chromosome.end(), rng);
-        population[i] = Individual(chromosome);
+        Gene *chromosome = population.row(i);
+        iota(chromosome, chromosome + numGenes, Gene(0));
+        rng.shuffle(chromosome, chromosome + numGenes);
     }
 }
 
-void GeneticAlgorithm::evaluateIndividual(Individual &ind) {
-    // CRÍTICO: Criar uma CÓPIA COMPLETA dos dados do problema
-    ProblemData dataCopy;
-    dataCopy.numJobs = problemData.numJobs;
-    dataCopy.numStages = problemData.numStages;
-    dataCopy.machinesPerStage = problemData.machinesPerStage;
-
-    // Copiar jobs
-    dataCopy.jobs.clear();
-    dataCopy.jobs.reserve(problemData.numJobs);
-    for (const auto &job: problemData.jobs) {
-        dataCopy.jobs.push_back(job);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::initializeWorkers() {
+    stopLocalSearch.store(false);
+
+    // Um contexto (RNG + dados do problema) por thread; o RNG principal fica com seleção e substituição.
+    // Uma única chave do RNG principal para todos: o fluxo principal não depende do número de threads
+    workers.clear();
+    workers.resize(max(1, params.numThreads));
+    uint64_t workerKey = rng();
+    for (int w = 0; w < (int) workers.size(); ++w) {
+        Worker &worker = workers[w];
+        worker.rng = RandomStream(workerKey, w);
+        worker.problemData = problemData;
+        worker.scratch.resize(4, numGenes);
+        worker.crossoverUsage.reset(crossoverBandit.size());
+        worker.mutationUsage.reset(mutationBandit.size());
     }
+    threadPool.reset(workers.size() > 1 ? new ThreadPool((int) workers.size()) : nullptr);
+    if (threadPool) threadPool->setLimit(threadLimit);
+}
 
-    // Inicializar máquinas
-    dataCopy.machines.clear();
-    for (int i = 1; i <= dataCopy.numStages; ++i) {
-        for (int l = 1; l <= dataCopy.machinesPerStage[i - 1]; ++l) {
-            dataCopy.machines.emplace(make_pair(i, l), Machine(i, l));
-        }
-    }
+template<typename Gene>
+double GeneticAlgorithm<Gene>::evaluate(const Gene *chromosome, Worker &worker) {
+    // CRÍTICO: o decodificador altera máquinas e jobs, então cada worker decodifica sobre a
+    // sua própria cópia dos dados do problema, zerada antes de cada avaliação
+    resetProblemData(worker.problemData);
 
     // Converter para 1-based
-    vector<int> chromosome1Based = ind.chromosome;
-    for (int &job: chromosome1Based) {
-        job += 1;
+    vector<int> &chromosome1Based = worker.decodeBuffer;
+    chromosome1Based.resize(numGenes);
+    for (int i = 0; i < numGenes; ++i) {
+        chromosome1Based[i] = chromosome[i] + 1;
     }
 
     // Decodificar
-    ind.fitness = decodeChromosome(chromosome1Based, dataCopy);
+    return decodeChromosome(chromosome1Based, worker.problemData);
 }
 
-void GeneticAlgorithm::evaluatePopulation() {
-    for (auto &ind: population) {
-        evaluateIndividual(ind);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::evaluatePopulation() {
+    auto evaluateRow = [&](int i, int w) { population.fitness(i) = evaluate(population.row(i), workers[w]); };
+    if (threadPool) {
+        threadPool->parallelFor(population.size(), evaluateRow);
+    } else {
+        for (int i = 0; i < population.size(); ++i) evaluateRow(i, 0);
     }
+    rebuildPopulationStats();
 
-    auto bestIter = min_element(population.begin(), population.end());
-    if (bestIter->fitness < bestSolution.fitness) {
-        bestSolution = *bestIter;
+    int bestIdx = populationStats.bestIndex();
+    if (population.fitness(bestIdx) < bestSolution.fitness) {
+        updateBestSolution(population.row(bestIdx), population.fitness(bestIdx));
         generationsWithoutImprovement = 0;
     } else {
         generationsWithoutImprovement++;
     }
 }
 
-void GeneticAlgorithm::recordGenerationStats(double elapsedTime) {
+template<typename Gene>
+void GeneticAlgorithm<Gene>::recordGenerationStats(double elapsedTime) {
     GenerationStats stats;
     stats.generation = currentGeneration;
     stats.elapsedTime = elapsedTime;
 
-    stats.bestFitness = min_element(population.begin(), population.end())->fitness;
-    stats.worstFitness = max_element(population.begin(), population.end())->fitness;
-
-    double sum = 0.0;
-    for (const auto &ind: population) {
-        sum += ind.fitness;
-    }
-    stats.avgFitness = sum / population.size();
+    stats.bestFitness = populationStats.best();
+    stats.worstFitness = populationStats.worst();
+    stats.avgFitness = populationStats.average();
 
     history.push_back(stats);
 }
 
-vector<Individual> GeneticAlgorithm::tournamentSelection() {
-    vector<Individual> matingPool;
-    matingPool.reserve(params.populationSize);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::updateBestSolution(const Gene *chromosome, double fitness) {
+    bestSolution.chromosome.assign(chromosome, chromosome + numGenes);
+    bestSolution.fitness = fitness;
+}
 
-    uniform_int_distribution<int> dist(0, params.populationSize - 1);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::tournamentSelection() {
+    matingPool.clear();
 
     for (int i = 0; i < params.populationSize; ++i) {
-        int idx1 = dist(rng);
-        int idx2 = dist(rng);
+        int idx1 = (int) rng.below(params.populationSize);
+        int idx2 = (int) rng.below(params.populationSize);
 
-        if (population[idx1].fitness < population[idx2].fitness) {
-            matingPool.push_back(population[idx1]);
+        if (population.fitness(idx1) < population.fitness(idx2)) {
+            matingPool.push_back(idx1);
         } else {
-            matingPool.push_back(population[idx2]);
+            matingPool.push_back(idx2);
         }
     }
-
-    return matingPool;
 }
 
-vector<Individual> GeneticAlgorithm::rouletteWheelSelection() {
-    vector<Individual> matingPool;
-    matingPool.reserve(params.populationSize);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::rouletteWheelSelection() {
+    matingPool.clear();
 
-    double maxFitness = max_element(population.begin(), population.end())->fitness;
-    double minFitness = min_element(population.begin(), population.end())->fitness;
+    double maxFitness = populationStats.worst();
+    double minFitness = populationStats.best();
 
-    // Se todos têm o mesmo fitness, retornar cópias aleatórias
+    // Se todos têm o mesmo fitness, escolher índices aleatórios
     if (maxFitness == minFitness) {
-        uniform_int_distribution<int> dist(0, params.populationSize - 1);
         for (int i = 0; i < params.populationSize; ++i) {
-            matingPool.push_back(population[dist(rng)]);
+            matingPool.push_back((int) rng.below(params.populationSize));
         }
-        return matingPool;
+        return;
     }
 
-    vector<double> invertedFitness(params.populationSize);
+    // Roleta montada uma vez por geração como soma prefixa do fitness invertido;
+    // cada giro é uma busca binária: O(P) para montar e O(log P) por sorteio
+    rouletteCumulative.resize(params.populationSize);
     double totalFitness = 0.0;
 
     for (int i = 0; i < params.populationSize; ++i) {
-        invertedFitness[i] = maxFitness - population[i].fitness + 1.0;
-        totalFitness += invertedFitness[i];
+        totalFitness += maxFitness - population.fitness(i) + 1.0;
+        rouletteCumulative[i] = totalFitness;
     }
 
-    uniform_real_distribution<double> dist(0.0, totalFitness);
-
     for (int i = 0; i < params.populationSize; ++i) {
-        double spin = dist(rng);
-        double cumulative = 0.0;
+        double spin = rng.uniform(0.0, totalFitness);
 
-        for (int j = 0; j < params.populationSize; ++j) {
-            cumulative += invertedFitness[j];
-            if (cumulative >= spin) {
-                matingPool.push_back(population[j]);
-                break;
-            }
-        }
+        // Primeiro j com cumulativo >= spin, como na varredura linear
+        int j = lower_bound(rouletteCumulative.begin(), rouletteCumulative.end(), spin) - rouletteCumulative.begin();
+        matingPool.push_back(min(j, params.populationSize - 1));
     }
-
-    return matingPool;
 }
 
-vector<Individual> GeneticAlgorithm::performSelection() {
-    if (params.selectionType == SelectionType::TOURNAMENT) {
-        return tournamentSelection();
+// Os operadores do laço principal são parâmetros de template: cada combinação é uma instância
+// própria de evolve(), escolhida uma única vez em dispatchEvolution, sem switch por chamada.
+template<typename Gene>
+template<SelectionType S>
+void GeneticAlgorithm<Gene>::performSelection() {
+    if constexpr (S == SelectionType::TOURNAMENT) {
+        tournamentSelection();
     } else {
-        return rouletteWheelSelection();
+        rouletteWheelSelection();
     }
 }
 
-pair<Individual, Individual> GeneticAlgorithm::orderBasedCrossover(const Individual &p1, const Individual &p2) {
-    int n = p1.chromosome.size();
-    vector<int> child1(n, -1), child2(n, -1);
-
-    vector<bool> mask(n);
-    uniform_int_distribution<int> dist(0, 1);
-    for (int i = 0; i < n; ++i) {
-        mask[i] = dist(rng) == 1;
-    }
-
-    for (int i = 0; i < n; ++i) {
-        if (mask[i]) {
-            child1[i] = p1.chromosome[i];
-            child2[i] = p2.chromosome[i];
-        }
-    }
-
-    int pos1 = 0, pos2 = 0;
-    for (int i = 0; i < n; ++i) {
-        if (child1[i] == -1) {
-            while (find(child1.begin(), child1.end(), p2.chromosome[pos1]) != child1.end()) {
-                pos1++;
-            }
-            child1[i] = p2.chromosome[pos1++];
-        }
-
-        if (child2[i] == -1) {
-            while (find(child2.begin(), child2.end(), p1.chromosome[pos2]) != child2.end()) {
-                pos2++;
-            }
-            child2[i] = p1.chromosome[pos2++];
-        }
-    }
-
-    return {Individual(child1), Individual(child2)};
+// Os crossovers escrevem direto nas linhas dos filhos usando os kernels lineares de
+// crossover_kernels.h
+template<typename Gene>
+void GeneticAlgorithm<Gene>::orderBasedCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2,
+                                                 Worker &worker) {
+    orderBasedKernel(p1, p2, child1, child2, numGenes, worker.rng, worker.marks);
 }
 
-pair<Individual, Individual> GeneticAlgorithm::partialMappedCrossover(const Individual &p1, const Individual &p2) {
-    int n = p1.chromosome.size();
+template<typename Gene>
+void GeneticAlgorithm<Gene>::partialMappedCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2,
+                                                    Worker &worker) {
+    partialMappedKernel(p1, p2, child1, child2, numGenes, worker.rng, worker.marks);
+}
 
-    uniform_int_distribution<int> dist(0, n - 1);
-    int cut1 = dist(rng);
-    int cut2 = dist(rng);
-    if (cut1 > cut2) swap(cut1, cut2);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::similarBlock2PointCrossover(const Gene *p1, const Gene *p2, Gene *child1,
+                                                         Gene *child2, Worker &worker) {
+    twoPointOrderCrossover(p1, p2, child1, child2, worker);
+}
 
-    vector<int> child1 = p1.chromosome;
-    vector<int> child2 = p2.chromosome;
+template<typename Gene>
+void GeneticAlgorithm<Gene>::onePointOrderCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2,
+                                                    Worker &worker) {
+    onePointOrderKernel(p1, p2, child1, child2, numGenes, worker.rng, worker.marks);
+}
 
-    map<int, int> mapping1, mapping2;
-    for (int i = cut1; i <= cut2; ++i) {
-        mapping1[p2.chromosome[i]] = p1.chromosome[i];
-        mapping2[p1.chromosome[i]] = p2.chromosome[i];
-    }
+template<typename Gene>
+void GeneticAlgorithm<Gene>::twoPointOrderCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2,
+                                                    Worker &worker) {
+    twoPointOrderKernel(p1, p2, child1, child2, numGenes, worker.rng, worker.marks);
+}
 
-    for (int i = cut1; i <= cut2; ++i) {
-        child1[i] = p2.chromosome[i];
-        child2[i] = p1.chromosome[i];
+template<typename Gene>
+void GeneticAlgorithm<Gene>::crossoverWithArm(int arm, const Gene *p1, const Gene *p2, Gene *child1, Gene *child2,
+                                              Worker &worker) {
+    // Braços do crossoverBandit, na ordem de CrossoverType
+    switch (arm) {
+        case 1: return partialMappedCrossover(p1, p2, child1, child2, worker);
+        case 2: return similarBlock2PointCrossover(p1, p2, child1, child2, worker);
+        case 3: return onePointOrderCrossover(p1, p2, child1, child2, worker);
+        case 4: return twoPointOrderCrossover(p1, p2, child1, child2, worker);
+        default: return orderBasedCrossover(p1, p2, child1, child2, worker);
     }
+}
 
-    for (int i = 0; i < n; ++i) {
-        if (i >= cut1 && i <= cut2) continue;
-
-        while (find(child1.begin() + cut1, child1.begin() + cut2 + 1, child1[i]) != child1.begin() + cut2 + 1) {
-            child1[i] = mapping1[child1[i]];
-        }
-
-        while (find(child2.begin() + cut1, child2.begin() + cut2 + 1, child2[i]) != child2.begin() + cut2 + 1) {
-            child2[i] = mapping2[child2[i]];
-        }
+template<typename Gene>
+template<CrossoverType C>
+void GeneticAlgorithm<Gene>::performCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2,
+                                              Worker &worker) {
+    if constexpr (C == CrossoverType::ADAPTIVE) {
+        worker.lastCrossoverArm = crossoverBandit.select(worker.rng.uniform01());
+        crossoverWithArm(worker.lastCrossoverArm, p1, p2, child1, child2, worker);
     }
-
-    return {Individual(child1), Individual(child2)};
+    else if constexpr (C == CrossoverType::PMX) partialMappedCrossover(p1, p2, child1, child2, worker);
+    else if constexpr (C == CrossoverType::SB2OX) similarBlock2PointCrossover(p1, p2, child1, child2, worker);
+    else if constexpr (C == CrossoverType::OPX) onePointOrderCrossover(p1, p2, child1, child2, worker);
+    else if constexpr (C == CrossoverType::TPX) twoPointOrderCrossover(p1, p2, child1, child2, worker);
+    else orderBasedCrossover(p1, p2, child1, child2, worker);
 }
 
-pair<Individual, Individual> GeneticAlgorithm::similarBlock2PointCrossover(const Individual &p1, const Individual &p2) {
-    return twoPointOrderCrossover(p1, p2);
+// Mutações delegam aos movimentos de permutation_moves.h, também usados pelo parallel tempering
+template<typename Gene>
+void GeneticAlgorithm<Gene>::insertMutation(Gene *chromosome, Worker &worker) {
+    insertMove(chromosome, numGenes, worker.rng);
 }
 
-pair<Individual, Individual> GeneticAlgorithm::onePointOrderCrossover(const Individual &p1, const Individual &p2) {
-    int n = p1.chromosome.size();
-    uniform_int_distribution<int> dist(1, n - 1);
-    int cutPoint = dist(rng);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::interchangeMutation(Gene *chromosome, Worker &worker) {
+    interchangeMove(chromosome, numGenes, worker.rng);
+}
 
-    vector<int> child1, child2;
-    set<int> used1, used2;
+template<typename Gene>
+void GeneticAlgorithm<Gene>::swapMutation(Gene *chromosome, Worker &worker) {
+    adjacentSwapMove(chromosome, numGenes, worker.rng);
+}
 
-    for (int i = 0; i < cutPoint; ++i) {
-        child1.push_back(p1.chromosome[i]);
-        child2.push_back(p2.chromosome[i]);
-        used1.insert(p1.chromosome[i]);
-        used2.insert(p2.chromosome[i]);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::mutationWithArm(int arm, Gene *chromosome, Worker &worker) {
+    // Braços do mutationBandit, na ordem de MutationType
+    switch (arm) {
+        case 1: interchangeMutation(chromosome, worker);
+            break;
+        case 2: swapMutation(chromosome, worker);
+            break;
+        default: insertMutation(chromosome, worker);
     }
+}
 
-    for (int i = 0; i < n; ++i) {
-        if (used1.find(p2.chromosome[i]) == used1.end()) {
-            child1.push_back(p2.chromosome[i]);
-        }
-        if (used2.find(p1.chromosome[i]) == used2.end()) {
-            child2.push_back(p1.chromosome[i]);
-        }
+template<typename Gene>
+template<MutationType M>
+void GeneticAlgorithm<Gene>::performMutation(Gene *chromosome, Worker &worker) {
+    if constexpr (M == MutationType::ADAPTIVE) {
+        worker.lastMutationArm = mutationBandit.select(worker.rng.uniform01());
+        mutationWithArm(worker.lastMutationArm, chromosome, worker);
     }
-
-    return {Individual(child1), Individual(child2)};
+    else if constexpr (M == MutationType::INTERCHANGE) interchangeMutation(chromosome, worker);
+    else if constexpr (M == MutationType::SWAP) swapMutation(chromosome, worker);
+    else insertMutation(chromosome, worker);
 }
 
-pair<Individual, Individual> GeneticAlgorithm::twoPointOrderCrossover(const Individual &p1, const Individual &p2) {
-    int n = p1.chromosome.size();
-    uniform_int_distribution<int> dist(0, n - 1);
-    int cut1 = dist(rng);
-    int cut2 = dist(rng);
-    if (cut1 > cut2) swap(cut1, cut2);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::performMutation(Gene *chromosome) {
+    // Versão com despacho em tempo de execução, usada fora do laço principal (seed e restart)
+    switch (params.mutationType) {
+        case MutationType::INSERT: insertMutation(chromosome, workers[0]);
+            break;
+        case MutationType::INTERCHANGE: interchangeMutation(chromosome, workers[0]);
+            break;
+        case MutationType::SWAP: swapMutation(chromosome, workers[0]);
+            break;
+        case MutationType::ADAPTIVE: performMutation<MutationType::ADAPTIVE>(chromosome, workers[0]);
+            break;
+    }
+}
 
-    vector<int> child1(n, -1), child2(n, -1);
-    set<int> used1, used2;
+template<typename Gene>
+void GeneticAlgorithm<Gene>::localSearch(int index) {
+    Worker &worker = workers[0];
+    worker.scratch.copyRow(0, population, index);
+    improveByInsertion(worker);
+    population.copyRow(index, worker.scratch, 0);
+}
 
-    for (int i = cut1; i <= cut2; ++i) {
-        child1[i] = p1.chromosome[i];
-        child2[i] = p2.chromosome[i];
-        used1.insert(p1.chromosome[i]);
-        used2.insert(p2.chromosome[i]);
-    }
+template<typename Gene>
+void GeneticAlgorithm<Gene>::improveByInsertion(Worker &worker) {
+    int maxEval = params.localSearchIntensity * numGenes;
+    int evalCount = 0;
 
-    int fill1 = (cut2 + 1) % n;
-    int fill2 = (cut2 + 1) % n;
+    // Linha 0 do scratch é a solução corrente (sempre a melhor encontrada), linha 1 o vizinho
+    Population &scratch = worker.scratch;
+    scratch.fitness(0) = evaluate(scratch.row(0), worker);
 
-    for (int i = 0; i < n; ++i) {
-        int idx = (cut2 + 1 + i) % n;
+    while (evalCount < maxEval && !stopLocalSearch.load(memory_order_relaxed)) {
+        scratch.copyRow(1, scratch, 0);
+        insertMutation(scratch.row(1), worker);
+        scratch.fitness(1) = evaluate(scratch.row(1), worker);
 
-        if (used1.find(p2.chromosome[idx]) == used1.end()) {
-            while (child1[fill1] != -1) fill1 = (fill1 + 1) % n;
-            child1[fill1] = p2.chromosome[idx];
-            fill1 = (fill1 + 1) % n;
+        if (scratch.fitness(1) < scratch.fitness(0)) {
+            scratch.copyRow(0, scratch, 1);
         }
 
-        if (used2.find(p1.chromosome[idx]) == used2.end()) {
-            while (child2[fill2] != -1) fill2 = (fill2 + 1) % n;
-            child2[fill2] = p1.chromosome[idx];
-            fill2 = (fill2 + 1) % n;
-        }
+        evalCount++;
     }
+}
 
-    return {Individual(child1), Individual(child2)};
+// ===== BUSCA LOCAL ASSÍNCRONA =====
+
+template<typename Gene>
+void GeneticAlgorithm<Gene>::startLocalSearchPool() {
+    stopLocalSearch.store(false);
+    localSearchInjected = 0;
+    localSearchQueue.clear();
+    localSearchResults.clear();
+
+    localSearchWorkers.clear();
+    localSearchWorkers.resize(params.localSearchThreads);
+    uint64_t workerKey = rng();
+    for (int w = 0; w < params.localSearchThreads; ++w) {
+        Worker &worker = localSearchWorkers[w];
+        worker.rng = RandomStream(workerKey, w);
+        worker.problemData = problemData;
+        worker.scratch.resize(2, numGenes);
+    }
+    for (int w = 0; w < params.localSearchThreads; ++w) {
+        localSearchPool.emplace_back(&GeneticAlgorithm::localSearchWorkerLoop, this, w);
+    }
 }
 
-pair<Individual, Individual> GeneticAlgorithm::performCrossover(const Individual &p1, const Individual &p2) {
-    switch (params.crossoverType) {
-        case CrossoverType::OBX: return orderBasedCrossover(p1, p2);
-        case CrossoverType::PMX: return partialMappedCrossover(p1, p2);
-        case CrossoverType::SB2OX: return similarBlock2PointCrossover(p1, p2);
-        case CrossoverType::OPX: return onePointOrderCrossover(p1, p2);
-        case CrossoverType::TPX: return twoPointOrderCrossover(p1, p2);
-        default: return orderBasedCrossover(p1, p2);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::stopLocalSearchPool() {
+    {
+        lock_guard<mutex> lock(localSearchMutex);
+        stopLocalSearch.store(true);
     }
+    localSearchReady.notify_all();
+    for (auto &t: localSearchPool) {
+        t.join();
+    }
+    localSearchPool.clear();
+    stopLocalSearch.store(false);
 }
 
-void GeneticAlgorithm::insertMutation(Individual &ind) {
-    int n = ind.chromosome.size();
-    if (n < 2) return;
+template<typename Gene>
+void GeneticAlgorithm<Gene>::localSearchWorkerLoop(int w) {
+    resetThreadAffinity();
+    Worker &worker = localSearchWorkers[w];
+    LocalSearchJob job;
 
-    uniform_int_distribution<int> dist(0, n - 1);
+    while (true) {
+        {
+            unique_lock<mutex> lock(localSearchMutex);
+            localSearchReady.wait(lock, [&] { return stopLocalSearch.load() || !localSearchQueue.empty(); });
+            if (stopLocalSearch.load()) return;
+            job = move(localSearchQueue.front());
+            localSearchQueue.pop_front();
+        }
 
-    int pos1 = dist(rng);
-    int pos2 = dist(rng);
+        copy(job.chromosome.begin(), job.chromosome.end(), worker.scratch.row(0));
+        improveByInsertion(worker);
 
-    // Garantir que pos1 != pos2
-    while (pos1 == pos2) {
-        pos2 = dist(rng);
+        // Só volta para a população o que melhorou o elite recebido
+        if (worker.scratch.fitness(0) < job.fitness) {
+            job.chromosome.assign(worker.scratch.row(0), worker.scratch.row(0) + numGenes);
+            job.fitness = worker.scratch.fitness(0);
+            lock_guard<mutex> lock(localSearchMutex);
+            localSearchResults.push_back(move(job));
+        }
     }
+}
 
-    int job = ind.chromosome[pos1];
-    ind.chromosome.erase(ind.chromosome.begin() + pos1);
-
-    // Ajustar pos2 se necessário
-    if (pos2 > pos1) pos2--;
-
-    ind.chromosome.insert(ind.chromosome.begin() + pos2, job);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::submitLocalSearch(int index) {
+    LocalSearchJob job{vector<Gene>(population.row(index), population.row(index) + numGenes),
+                       population.fitness(index)};
+    {
+        lock_guard<mutex> lock(localSearchMutex);
+        // Fila limitada a um elite por thread: o mais antigo dá lugar ao mais recente
+        if ((int) localSearchQueue.size() >= params.localSearchThreads) localSearchQueue.pop_front();
+        localSearchQueue.push_back(move(job));
+    }
+    localSearchReady.notify_one();
 }
 
-void GeneticAlgorithm::interchangeMutation(Individual &ind) {
-    int n = ind.chromosome.size();
-    if (n < 2) return;
+template<typename Gene>
+void GeneticAlgorithm<Gene>::injectLocalSearchResults() {
+    vector<LocalSearchJob> improved;
+    {
+        lock_guard<mutex> lock(localSearchMutex);
+        improved.swap(localSearchResults);
+    }
 
-    uniform_int_distribution<int> dist(0, n - 1);
+    // Cada solução melhorada entra no lugar do pior, se for melhor que ele
+    for (const LocalSearchJob &job: improved) {
+        int worstIdx = getWorstIndex();
+        double worstFitness = population.fitness(worstIdx);
+        if (job.fitness >= worstFitness) continue;
 
-    int pos1 = dist(rng);
-    int pos2 = dist(rng);
+        population.setRow(worstIdx, job.chromosome.data(), job.fitness);
+        populationStats.update(worstIdx, worstFitness, job.fitness);
+        localSearchInjected++;
 
-    // Garantir que pos1 != pos2
-    while (pos1 == pos2) {
-        pos2 = dist(rng);
+        if (job.fitness < bestSolution.fitness) {
+            console() << "Geracao " << currentGeneration << ": Busca local assincrona melhorou! "
+                    << bestSolution.fitness << " -> " << job.fitness << endl;
+            updateBestSolution(job.chromosome.data(), job.fitness);
+            generationsWithoutImprovement = 0;
+        }
     }
-
-    swap(ind.chromosome[pos1], ind.chromosome[pos2]);
 }
 
-void GeneticAlgorithm::swapMutation(Individual &ind) {
-    int n = ind.chromosome.size();
-    if (n < 2) return;
-
-    uniform_int_distribution<int> dist(0, n - 2);
-
-    int pos = dist(rng);
-    swap(ind.chromosome[pos], ind.chromosome[pos + 1]);
+template<typename Gene>
+void GeneticAlgorithm<Gene>::exchangeMigrants() {
+    // O protocolo usa os IDs dos jobs a partir de 1, como o decodificador e o PSO
+    vector<int> elite(bestSolution.chromosome.size());
+    for (size_t i = 0; i < elite.size(); ++i) elite[i] = bestSolution.chromosome[i] + 1;
+    elitePort->publish(elite, bestSolution.fitness);
+
+    migrantBuffer.resize(1, numGenes);
+    vector<int> migrant;
+    double reportedFitness;
+    while (elitePort->receive(migrant, reportedFitness)) {
+        if ((int) migrant.size() != numGenes) continue;
+
+        // Reavaliado aqui: o fitness informado pode vir de outro processo (e de outro algoritmo)
+        Gene *row = migrantBuffer.row(0);
+        for (int i = 0; i < numGenes; ++i) row[i] = (Gene) (migrant[i] - 1);
+        double fitness = evaluate(row, workers[0]);
+        migrantBuffer.fitness(0) = fitness;
+
+        int worstIdx = getWorstIndex();
+        if (fitness >= population.fitness(worstIdx) || isDuplicate(migrantBuffer, 0)) continue;
+        replaceIndividual(worstIdx, migrantBuffer, 0);
+        migrantsAccepted++;
+
+        if (fitness < bestSolution.fitness) {
+            console() << "Geracao " << currentGeneration << ": Imigrante melhorou! "
+                    << bestSolution.fitness << " -> " << fitness << endl;
+            updateBestSolution(row, fitness);
+            generationsWithoutImprovement = 0;
+        }
+    }
 }
 
-void GeneticAlgorithm::performMutation(Individual &ind) {
-    switch (params.mutationType) {
-        case MutationType::INSERT: insertMutation(ind);
-            break;
-        case MutationType::INTERCHANGE: interchangeMutation(ind);
-            break;
-        case MutationType::SWAP: swapMutation(ind);
-            break;
+// ============ CHECKPOINT ============
+// População, melhor solução, fluxo principal e o da amostragem de diversidade, contadores e
+// histórico. Os fluxos dos workers não entram: cada geração os deriva de uma chave do fluxo
+// principal. Os bandits e a busca local em andamento também não: recomeçam do zero na retomada.
+
+template<typename Gene>
+void GeneticAlgorithm<Gene>::saveCheckpoint(double elapsedTime, bool wait) {
+    CheckpointBuffer &buffer = checkpointWriter->buffer();
+    buffer.begin(CheckpointKind::GA);
+    buffer.put<int32_t>(numGenes);
+    buffer.put<int32_t>(population.size());
+    buffer.put<uint32_t>(sizeof(Gene));
+    buffer.put(elapsedTime);
+    buffer.put<int32_t>(currentGeneration);
+    buffer.put<int32_t>(generationsWithoutImprovement);
+
+    buffer.putArray(population.row(0), (size_t) population.size() * numGenes);
+    buffer.putVector(population.allFitness());
+    buffer.putVector(bestSolution.chromosome);
+    buffer.put(bestSolution.fitness);
+
+    buffer.putRng(rng);
+    buffer.putRng(diversityMeter.sampler());
+    buffer.putVector(history);
+
+    if (wait) {
+        checkpointWriter->submitAndWait();
+    } else {
+        checkpointWriter->submit();
     }
+    lastCheckpointTime = elapsedTime;
 }
 
-void GeneticAlgorithm::localSearch(Individual &ind) {
-    int n = ind.chromosome.size();
-    int maxEval = params.localSearchIntensity * n;
-    int evalCount = 0;
-
-    Individual current = ind;
-    evaluateIndividual(current);
+template<typename Gene>
+bool GeneticAlgorithm<Gene>::loadCheckpoint() {
+    CheckpointReader reader;
+    if (!reader.open(params.checkpointFile, CheckpointKind::GA)) return false;
+
+    int32_t storedGenes = 0, storedSize = 0;
+    uint32_t geneBytes = 0;
+    reader.get(storedGenes);
+    reader.get(storedSize);
+    reader.get(geneBytes);
+    if (!reader.ok() || storedGenes != numGenes || storedSize != params.populationSize ||
+        geneBytes != sizeof(Gene)) {
+        console() << "AVISO: Checkpoint de outra instancia ou populacao, iniciando do zero" << endl;
+        return false;
+    }
 
-    Individual bestLocal = current;
+    // Tudo é lido em temporários: um arquivo truncado não deixa o GA pela metade
+    double elapsedTime = 0.0;
+    int32_t generation = 0, stagnation = 0;
+    reader.get(elapsedTime);
+    reader.get(generation);
+    reader.get(stagnation);
+
+    Population restored;
+    restored.resize(storedSize, numGenes);
+    reader.getArray(restored.row(0), (size_t) storedSize * numGenes);
+    vector<double> fitness;
+    reader.getVector(fitness);
+    Individual best;
+    reader.getVector(best.chromosome);
+    reader.get(best.fitness);
+
+    RandomStream mainRng, samplerRng;
+    reader.getRng(mainRng);
+    reader.getRng(samplerRng);
+    vector<GenerationStats> restoredHistory;
+    reader.getVector(restoredHistory);
+
+    if (!reader.ok() || (int) fitness.size() != storedSize || restoredHistory.empty()) {
+        console() << "AVISO: Checkpoint incompleto, iniciando do zero" << endl;
+        return false;
+    }
 
-    while (evalCount < maxEval) {
-        Individual neighbor = current;
-        insertMutation(neighbor);
-        evaluateIndividual(neighbor);
+    population.swap(restored);
+    for (int i = 0; i < storedSize; ++i) {
+        population.fitness(i) = fitness[i];
+    }
+    rebuildPopulationStats();
+    bestSolution = best;
+    currentGeneration = generation;
+    generationsWithoutImprovement = stagnation;
+    history.swap(restoredHistory);
 
-        if (neighbor.fitness < bestLocal.fitness) {
-            bestLocal = neighbor;
-            current = neighbor;
-        }
+    rng = mainRng;
+    diversityMeter.restoreSampler(samplerRng);
 
-        evalCount++;
-    }
+    resumedTime = elapsedTime;
+    return true;
+}
 
-    ind = bestLocal;
+template<typename Gene>
+double GeneticAlgorithm<Gene>::coolingProgress(double elapsedSeconds, double generation) const {
+    if (params.maxGenerations > 0) return generation / params.maxGenerations;
+    return elapsedSeconds / params.maxCPUTimeSeconds;
 }
 
-void GeneticAlgorithm::halfGenesMutation(Individual &ind) {
-    int n = ind.chromosome.size();
+template<typename Gene>
+void GeneticAlgorithm<Gene>::halfGenesMutation(Gene *chromosome) {
+    int n = numGenes;
     int halfN = max(1, n / 2);
 
     vector<int> indices(n);
     iota(indices.begin(), indices.end(), 0);
-    shuffle(indices.begin(), indices.end(), rng);
+    rng.shuffle(indices.begin(), indices.end());
     indices.resize(halfN);
 
-    vector<int> selectedGenes;
+    vector<Gene> selectedGenes;
     for (int idx: indices) {
-        selectedGenes.push_back(ind.chromosome[idx]);
+        selectedGenes.push_back(chromosome[idx]);
     }
 
-    shuffle(selectedGenes.begin(), selectedGenes.end(), rng);
+    rng.shuffle(selectedGenes.begin(), selectedGenes.end());
 
     for (int i = 0; i < halfN; ++i) {
-        ind.chromosome[indices[i]] = selectedGenes[i];
+        chromosome[indices[i]] = selectedGenes[i];
     }
 }
 
-void GeneticAlgorithm::restartProcedure() {
-    cout << "  -> Restart: Regenerando populacao com diversidade..." << endl;
+template<typename Gene>
+void GeneticAlgorithm<Gene>::restartProcedure() {
+    console() << "  -> Restart: Regenerando populacao com diversidade..." << endl;
 
-    // Ordenar população
-    sort(population.begin(), population.end());
+    // Ordenar população: índices ordenados por fitness e linhas copiadas nessa ordem
+    vector<int> order(params.populationSize);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b) { return population.fitness(a) < population.fitness(b); });
+    restartBuffer.resize(params.populationSize, numGenes);
+    for (int i = 0; i < params.populationSize; ++i) {
+        restartBuffer.copyRow(i, population, order[i]);
+    }
+    population.swap(restartBuffer);
 
     // Manter apenas os TOP 10% (mais elite)
     int eliteCount = max(1, params.populationSize / 10);
 
-    vector<int> baseChromosome(problemData.numJobs);
-    iota(baseChromosome.begin(), baseChromosome.end(), 0);
-
-    uniform_int_distribution<int> eliteDist(0, eliteCount - 1);
-
     // ============ DIAGNÓSTICO: Verificar elite ============
-    cout << "  -> Elite preservada (top " << eliteCount << "):" << endl;
+    console() << "  -> Elite preservada (top " << eliteCount << "):" << endl;
     for (int i = 0; i < min(3, eliteCount); ++i) {
-        cout << "     [" << i << "] Fitness=" << population[i].fitness << " Chr=[";
-        for (int j = 0; j < min(8, (int) population[i].chromosome.size()); ++j) {
-            cout << population[i].chromosome[j];
-            if (j < min(8, (int) population[i].chromosome.size()) - 1) cout << ",";
+        console() << "     [" << i << "] Fitness=" << population.fitness(i) << " Chr=[";
+        for (int j = 0; j < min(8, numGenes); ++j) {
+            console() << (int) population.row(i)[j];
+            if (j < min(8, numGenes) - 1) console() << ",";
         }
-        cout << "...]" << endl;
+        console() << "...]" << endl;
     }
     // ======================================================
 
     // 10%-30%: Elite com 1-3 mutações
     for (int i = eliteCount; i < params.populationSize * 3 / 10; ++i) {
-        int eliteIdx = eliteDist(rng);
-        population[i] = population[eliteIdx];
+        int eliteIdx = (int) rng.below(eliteCount);
+        population.copyRow(i, population, eliteIdx);
 
-        int numMutations = 1 + (rng() % 3);
+        int numMutations = 1 + (int) rng.below(3);
         for (int m = 0; m < numMutations; ++m) {
-            performMutation(population[i]);
+            performMutation(population.row(i));
         }
     }
 
     // 30%-50%: Elite com half genes mutation
     for (int i = params.populationSize * 3 / 10; i < params.populationSize / 2; ++i) {
-        int eliteIdx = eliteDist(rng);
-        population[i] = population[eliteIdx];
-        halfGenesMutation(population[i]);
+        int eliteIdx = (int) rng.below(eliteCount);
+        population.copyRow(i, population, eliteIdx);
+        halfGenesMutation(population.row(i));
     }
 
     // 50%-100%: Completamente aleatórios (DIVERSIDADE FORTE)
     int randomStart = params.populationSize / 2;
     for (int i = randomStart; i < params.populationSize; ++i) {
-        vector<int> chromosome = baseChromosome;
-        shuffle(chromosome.begin(), chromosome.end(), rng);
-        population[i] = Individual(chromosome);
+        Gene *chromosome = population.row(i);
+        iota(chromosome, chromosome + numGenes, Gene(0));
+        rng.shuffle(chromosome, chromosome + numGenes);
     }
 
     // ============ DIAGNÓSTICO: Verificar aleatorios gerados ============
-    cout << "  -> Primeiros 3 aleatorios gerados (indices " << randomStart << " a " << (randomStart + 2) << "):" <<
+    console() << "  -> Primeiros 3 aleatorios gerados (indices " << randomStart << " a " << (randomStart + 2) << "):" <<
             endl;
-    for (int i = randomStart; i < min(randomStart + 3, (int) population.size()); ++i) {
-        cout << "     [" << i << "] Chr=[";
-        for (int j = 0; j < min(8, (int) population[i].chromosome.size()); ++j) {
-            cout << population[i].chromosome[j];
-            if (j < min(8, (int) population[i].chromosome.size()) - 1) cout << ",";
+    for (int i = randomStart; i < min(randomStart + 3, population.size()); ++i) {
+        console() << "     [" << i << "] Chr=[";
+        for (int j = 0; j < min(8, numGenes); ++j) {
+            console() << (int) population.row(i)[j];
+            if (j < min(8, numGenes) - 1) console() << ",";
         }
-        cout << "...]" << endl;
+        console() << "...]" << endl;
     }
     // ===================================================================
 
     // Reavaliar TODA a população
-    cout << "  -> Avaliando populacao regenerada..." << endl;
+    console() << "  -> Avaliando populacao regenerada..." << endl;
     evaluatePopulation();
 
     // ============ DIAGNÓSTICO: Verificar fitness após avaliação ============
-    set<double> uniqueFit;
-    for (const auto &ind: population) {
-        uniqueFit.insert(ind.fitness);
-    }
-
-    auto minFit = min_element(population.begin(), population.end());
-    auto maxFit = max_element(population.begin(), population.end());
+    const vector<double> &fitness = population.allFitness();
+    set<double> uniqueFit(fitness.begin(), fitness.end());
 
     double sumFit = 0.0;
-    for (const auto &ind: population) {
-        sumFit += ind.fitness;
+    for (double f: fitness) {
+        sumFit += f;
     }
-    double avgFit = sumFit / population.size();
+    double avgFit = sumFit / fitness.size();
 
-    cout << "  -> Populacao apos restart:" << endl;
-    cout << "     Best=" << minFit->fitness << " Avg=" << avgFit << " Worst=" << maxFit->fitness << endl;
-    cout << "     Fitness unicos: " << uniqueFit.size() << " / " << params.populationSize << endl;
+    console() << "  -> Populacao apos restart:" << endl;
+    console() << "     Best=" << populationStats.best() << " Avg=" << avgFit << " Worst=" << populationStats.worst() << endl;
+    console() << "     Fitness unicos: " << uniqueFit.size() << " / " << params.populationSize << endl;
 
     // Mostrar alguns fitness
-    cout << "     Primeiros 5 fitness: [";
-    for (int i = 0; i < min(5, (int) population.size()); ++i) {
-        cout << population[i].fitness;
-        if (i < 4) cout << ", ";
+    console() << "     Primeiros 5 fitness: [";
+    for (int i = 0; i < min(5, population.size()); ++i) {
+        console() << population.fitness(i);
+        if (i < 4) console() << ", ";
     }
-    cout << "]" << endl;
+    console() << "]" << endl;
     // =======================================================================
 
     generationsWithoutImprovement = 0;
 
-    cout << "  -> Restart completo!" << endl;
+    console() << "  -> Restart completo!" << endl;
 }
 
 
-bool GeneticAlgorithm::isDuplicate(const Individual &ind) {
+template<typename Gene>
+bool GeneticAlgorithm<Gene>::isDuplicate(const Population &source, int row) {
     // MODIFICADO: Verificar apenas se já existe EXATAMENTE o mesmo cromossomo
     // Não bloquear indivíduos com mesmo fitness mas cromossomos diferentes
     int duplicateCount = 0;
-    for (const auto &existing: population) {
-        if (existing.chromosome == ind.chromosome) {
+    for (int i = 0; i < population.size(); ++i) {
+        if (population.rowsEqual(i, source, row)) {
             duplicateCount++;
             if (duplicateCount >= 2) {
                 // Permitir até 2 cópias
@@ -570,26 +732,31 @@ bool GeneticAlgorithm::isDuplicate(const Individual &ind) {
     return false;
 }
 
-int GeneticAlgorithm::getWorstIndex() {
-    int worstIdx = 0;
-    double worstFitness = population[0].fitness;
+template<typename Gene>
+int GeneticAlgorithm<Gene>::getWorstIndex() {
+    // Topo do heap de piores: O(1), mesmo índice que a varredura linear devolveria
+    return populationStats.worstIndex();
+}
 
-    for (int i = 1; i < params.populationSize; ++i) {
-        if (population[i].fitness > worstFitness) {
-            worstFitness = population[i].fitness;
-            worstIdx = i;
-        }
-    }
+template<typename Gene>
+void GeneticAlgorithm<Gene>::replaceIndividual(int index, const Population &source, int row) {
+    double oldFitness = population.fitness(index);
+    population.copyRow(index, source, row);
+    populationStats.update(index, oldFitness, source.fitness(row));
+}
 
-    return worstIdx;
+template<typename Gene>
+void GeneticAlgorithm<Gene>::rebuildPopulationStats() {
+    populationStats.build(population.allFitness());
 }
 
-void GeneticAlgorithm::replaceWorst(const Individual &child) {
+template<typename Gene>
+void GeneticAlgorithm<Gene>::replaceWorst(const Population &source, int row) {
     int worstIdx = getWorstIndex();
 
     // Aceitar se for melhor OU igual (permite convergência temporária mas mantém pressão evolutiva)
-    if (child.fitness <= population[worstIdx].fitness) {
-        population[worstIdx] = child;
+    if (source.fitness(row) <= population.fitness(worstIdx)) {
+        replaceIndividual(worstIdx, source, row);
     }
 }
 
@@ -764,77 +931,123 @@ void GeneticAlgorithm::replaceWorst(const Individual &child) {
 //     return bestSolution;
 // }
 
-Individual GeneticAlgorithm::runWithSeed(const vector<int> &seedChromosome) {
-    auto startTime = chrono::high_resolution_clock::now();
-
-    cout << "\n========================================" << endl;
-    cout << "INICIANDO ALGORITMO GENETICO (COM SEED)" << endl;
-    cout << "========================================" << endl;
-    cout << "Selecao: " << selectionTypeToString(params.selectionType) << endl;
-    cout << "Crossover: " << crossoverTypeToString(params.crossoverType) << endl;
-    cout << "Mutacao: " << mutationTypeToString(params.mutationType) << endl;
-    cout << "Populacao: " << params.populationSize << endl;
-    cout << "Prob. Crossover: " << params.crossoverProb << endl;
-    cout << "Prob. Mutacao: " << params.mutationProb << endl;
-    cout << "========================================\n" << endl;
-
-    initializePopulationWithSeed(seedChromosome);
-    evaluatePopulation();
-
-    auto elapsed0 = chrono::high_resolution_clock::now() - startTime;
-    recordGenerationStats(chrono::duration<double>(elapsed0).count());
+template<typename Gene>
+template<CrossoverType C, MutationType M>
+void GeneticAlgorithm<Gene>::breedPair(const Population &parents, int parent1, int parent2, double mutationProb,
+                                       Population &children, int child, Worker &worker) {
+    Gene *child1 = children.row(child);
+    Gene *child2 = children.row(child + 1);
+
+    // Com operadores adaptativos, cada operador é creditado pela redução de makespan do filho em
+    // relação ao melhor pai, dividida pelo tempo do operador somado ao da decodificação do filho
+    constexpr bool adaptiveCrossover = C == CrossoverType::ADAPTIVE;
+    constexpr bool adaptiveMutation = M == MutationType::ADAPTIVE;
+    constexpr bool timed = adaptiveCrossover || adaptiveMutation;
+    auto tick = [] {
+        return timed ? chrono::steady_clock::now() : chrono::steady_clock::time_point();
+    };
+
+    bool crossed = false, mutated1 = false, mutated2 = false;
+    long long crossoverNs = 0, mutationNs1 = 0, mutationNs2 = 0;
+    int mutationArm1 = 0, mutationArm2 = 0;
+
+    if (worker.rng.uniform01() < params.crossoverProb) {
+        auto opStart = tick();
+        performCrossover<C>(parents.row(parent1), parents.row(parent2), child1, child2, worker);
+        if constexpr (timed) crossoverNs = nanosecondsSince(opStart);
+        crossed = true;
+        worker.crossoverCount++;
+    } else {
+        children.copyRow(child, parents, parent1);
+        children.copyRow(child + 1, parents, parent2);
+    }
 
-    cout << "Populacao inicial avaliada:" << endl;
-    cout << "  Best: " << history[0].bestFitness << endl;
-    cout << "  Avg:  " << history[0].avgFitness << endl;
-    cout << "  Worst:" << history[0].worstFitness << endl;
+    if (worker.rng.uniform01() < mutationProb) {
+        auto opStart = tick();
+        performMutation<M>(child1, worker);
+        if constexpr (timed) mutationNs1 = nanosecondsSince(opStart);
+        mutated1 = true;
+        mutationArm1 = worker.lastMutationArm;
+        worker.mutationCount++;
+    }
 
-    set<double> uniqueFitness;
-    for (const auto &ind: population) {
-        uniqueFitness.insert(ind.fitness);
+    if (worker.rng.uniform01() < mutationProb) {
+        auto opStart = tick();
+        performMutation<M>(child2, worker);
+        if constexpr (timed) mutationNs2 = nanosecondsSince(opStart);
+        mutated2 = true;
+        mutationArm2 = worker.lastMutationArm;
+        worker.mutationCount++;
     }
-    cout << "  Fitness unicos: " << uniqueFitness.size() << " / " << params.populationSize << endl;
 
-    cout << "\nPrimeiros 5 cromossomos:" << endl;
-    for (int i = 0; i < min(5, (int) population.size()); ++i) {
-        cout << "  [" << i << "] Fitness=" << population[i].fitness << " Chr=[";
-        for (int j = 0; j < min(10, (int) population[i].chromosome.size()); ++j) {
-            cout << population[i].chromosome[j];
-            if (j < min(10, (int) population[i].chromosome.size()) - 1) cout << ",";
+    auto decodeStart = tick();
+    children.fitness(child) = evaluate(child1, worker);
+    long long decodeNs1 = timed ? nanosecondsSince(decodeStart) : 0;
+    decodeStart = tick();
+    children.fitness(child + 1) = evaluate(child2, worker);
+    long long decodeNs2 = timed ? nanosecondsSince(decodeStart) : 0;
+
+    if constexpr (timed) {
+        double parentFitness = min(parents.fitness(parent1), parents.fitness(parent2));
+        double gain1 = parentFitness - children.fitness(child);
+        double gain2 = parentFitness - children.fitness(child + 1);
+        if (adaptiveCrossover && crossed) {
+            worker.crossoverUsage.record(worker.lastCrossoverArm, max(0.0, gain1) + max(0.0, gain2),
+                                         crossoverNs + decodeNs1 + decodeNs2);
+        }
+        if (adaptiveMutation && mutated1) {
+            worker.mutationUsage.record(mutationArm1, gain1, mutationNs1 + decodeNs1);
+        }
+        if (adaptiveMutation && mutated2) {
+            worker.mutationUsage.record(mutationArm2, gain2, mutationNs2 + decodeNs2);
         }
-        cout << "...]" << endl;
     }
-    cout << endl;
+}
 
-    uniform_real_distribution<double> randDist(0.0, 1.0);
-    currentGeneration = 0;
+template<typename Gene>
+template<SelectionType S, CrossoverType C, MutationType M>
+void GeneticAlgorithm<Gene>::evolve(chrono::high_resolution_clock::time_point startTime) {
+    constexpr bool adaptiveCrossover = C == CrossoverType::ADAPTIVE;
+    constexpr bool adaptiveMutation = M == MutationType::ADAPTIVE;
+
+    int numPairs = params.populationSize / 2;
+    offspring.resize(2 * numPairs, numGenes);
+
+    bool asyncLocalSearch = params.localSearchThreads > 0 && params.localSearchFreq != INT_MAX;
+    if (asyncLocalSearch) startLocalSearchPool();
 
     while (true) {
         auto currentTime = chrono::high_resolution_clock::now();
         chrono::duration<double> elapsed = currentTime - startTime;
 
         if (elapsed.count() >= params.maxCPUTimeSeconds) {
-            cout << "\nTempo maximo atingido: " << elapsed.count() << "s" << endl;
+            console() << "\nTempo maximo atingido: " << elapsed.count() << "s" << endl;
+            break;
+        }
+        if (params.maxGenerations > 0 && currentGeneration >= params.maxGenerations) {
+            console() << "\nLimite de geracoes atingido: " << currentGeneration << endl;
             break;
         }
 
         currentGeneration++;
 
-        vector<Individual> matingPool = performSelection();
+        performSelection<S>();
 
         // ============ CALCULAR DIVERSIDADE E ADAPTAR PARÂMETROS ============
-        auto minFitIter = min_element(population.begin(), population.end());
-        auto maxFitIter = max_element(population.begin(), population.end());
-        double diversity = maxFitIter->fitness - minFitIter->fitness;
+        // Diversidade nas permutações (amostra de 2P pares); a amplitude do fitness só vai para o
+        // relatório, porque cromossomos diferentes podem empatar no makespan
+        diversityMeter.measure(population, 2 * params.populationSize);
+        double diversity = diversityMeter.combined();
+        double fitnessSpread = populationStats.worst() - populationStats.best();
 
-        // Temperatura para simulated annealing (diminui com o tempo)
-        double temperature = max(1.0, 50.0 * (1.0 - elapsed.count() / params.maxCPUTimeSeconds));
+        // Temperatura para simulated annealing (diminui com o tempo, ou com as gerações se limitadas)
+        double temperature = max(1.0, 50.0 * (1.0 - coolingProgress(elapsed.count(), currentGeneration)));
 
         // Adaptar taxa de mutação baseado na diversidade
         double adaptiveMutationProb = params.mutationProb;
-        if (diversity < 50.0) adaptiveMutationProb = min(0.15, params.mutationProb * 3.0);
-        if (diversity < 10.0) adaptiveMutationProb = min(0.25, params.mutationProb * 5.0);
-        if (diversity < 1.0) adaptiveMutationProb = min(0.4, params.mutationProb * 10.0);
+        if (diversity < 0.30) adaptiveMutationProb = min(0.15, params.mutationProb * 3.0);
+        if (diversity < 0.15) adaptiveMutationProb = min(0.25, params.mutationProb * 5.0);
+        if (diversity < 0.05) adaptiveMutationProb = min(0.4, params.mutationProb * 10.0);
 
         int crossoverCount = 0;
         int mutationCount = 0;
@@ -842,80 +1055,61 @@ Individual GeneticAlgorithm::runWithSeed(const vector<int> &seedChromosome) {
         int forcedReplacementCount = 0;
         // ===================================================================
 
+        // A população só muda na substituição, depois da reprodução: os pais são lidos direto
+        // dela e todos os pares são cruzados, mutados e avaliados de forma independente,
+        // em paralelo quando há mais de uma thread. Cada par sorteia do seu próprio fluxo (chave da
+        // geração, índice do par), então os filhos não dependem de qual thread cruzou cada par
+        uint64_t generationKey = rng();
+        auto breed = [&](int pair, int w) {
+            workers[w].rng = RandomStream(generationKey, pair);
+            breedPair<C, M>(population, matingPool[2 * pair], matingPool[2 * pair + 1], adaptiveMutationProb,
+                            offspring, 2 * pair, workers[w]);
+        };
+        if (threadPool) {
+            threadPool->parallelFor(numPairs, breed);
+        } else {
+            for (int pair = 0; pair < numPairs; ++pair) breed(pair, 0);
+        }
+        // workers[0] segue no código sequencial (busca local, restart) com um fluxo próprio
+        workers[0].rng = RandomStream(generationKey, numPairs);
+
+        for (Worker &worker: workers) {
+            crossoverCount += worker.crossoverCount;
+            mutationCount += worker.mutationCount;
+            worker.crossoverCount = 0;
+            worker.mutationCount = 0;
+        }
 
-        for (int i = 0; i < params.populationSize - 1; i += 2) {
-            Individual parent1 = matingPool[i];
-            Individual parent2 = matingPool[i + 1];
-
-            Individual child1, child2;
-
-            if (randDist(rng) < params.crossoverProb) {
-                auto children = performCrossover(parent1, parent2);
-                child1 = children.first;
-                child2 = children.second;
-                crossoverCount++;
-            } else {
-                child1 = parent1;
-                child2 = parent2;
-            }
-
-            if (randDist(rng) < adaptiveMutationProb) {
-                performMutation(child1);
-                mutationCount++;
-            }
-
-            if (randDist(rng) < adaptiveMutationProb) {
-                performMutation(child2);
-                mutationCount++;
-            }
-
-            evaluateIndividual(child1);
-            evaluateIndividual(child2);
+        // ============ NOVA ESTRATÉGIA DE SUBSTITUIÇÃO ============
+        // Aplicada na ordem dos filhos e com o RNG principal: o resultado não depende da
+        // ordem em que as threads terminaram
+        for (int child = 0; child < offspring.size(); ++child) {
+            double childFitness = offspring.fitness(child);
 
-            // ============ NOVA ESTRATÉGIA DE SUBSTITUIÇÃO ============
             // Encontrar índice do pior
             int worstIdx = getWorstIndex();
-            double worstFitness = population[worstIdx].fitness;
+            double worstFitness = population.fitness(worstIdx);
 
-            // Child1
-            if (child1.fitness <= worstFitness) {
+            if (childFitness <= worstFitness) {
                 // Aceitar se igual ou melhor
-                population[worstIdx] = child1;
+                replaceIndividual(worstIdx, offspring, child);
                 replacementCount++;
             } else {
                 // Aceitar pior com probabilidade baseada em temperatura (Simulated Annealing)
-                double delta = child1.fitness - worstFitness;
-                double acceptanceProb = exp(-delta / temperature);
-
-                if (randDist(rng) < acceptanceProb) {
-                    population[worstIdx] = child1;
-                    forcedReplacementCount++;
-                }
-            }
-
-            // Recalcular pior para child2
-            worstIdx = getWorstIndex();
-            worstFitness = population[worstIdx].fitness;
-
-            // Child2
-            if (child2.fitness <= worstFitness) {
-                population[worstIdx] = child2;
-                replacementCount++;
-            } else {
-                double delta = child2.fitness - worstFitness;
+                double delta = childFitness - worstFitness;
                 double acceptanceProb = exp(-delta / temperature);
 
-                if (randDist(rng) < acceptanceProb) {
-                    population[worstIdx] = child2;
+                if (rng.uniform01() < acceptanceProb) {
+                    replaceIndividual(worstIdx, offspring, child);
                     forcedReplacementCount++;
                 }
             }
-            // =========================================================
         }
+        // =========================================================
 
-        auto bestIter = min_element(population.begin(), population.end());
-        if (bestIter->fitness < bestSolution.fitness) {
-            bestSolution = *bestIter;
+        int bestIdx = populationStats.bestIndex();
+        if (population.fitness(bestIdx) < bestSolution.fitness) {
+            updateBestSolution(population.row(bestIdx), population.fitness(bestIdx));
             generationsWithoutImprovement = 0;
         } else {
             generationsWithoutImprovement++;
@@ -923,67 +1117,463 @@ Individual GeneticAlgorithm::runWithSeed(const vector<int> &seedChromosome) {
 
         recordGenerationStats(elapsed.count());
 
-        if (params.localSearchFreq != INT_MAX && currentGeneration % params.localSearchFreq == 0) {
-            auto bestIter = min_element(population.begin(), population.end());
-            int bestIdx = distance(population.begin(), bestIter);
-
-            double beforeLS = population[bestIdx].fitness;
-            localSearch(population[bestIdx]);
-            double afterLS = population[bestIdx].fitness;
-
-            if (population[bestIdx].fitness < bestSolution.fitness) {
-                bestSolution = population[bestIdx];
+        if constexpr (adaptiveCrossover || adaptiveMutation) {
+            for (Worker &worker: workers) {
+                crossoverBandit.usage().merge(worker.crossoverUsage);
+                mutationBandit.usage().merge(worker.mutationUsage);
+                worker.crossoverUsage.reset(crossoverBandit.size());
+                worker.mutationUsage.reset(mutationBandit.size());
+            }
+        }
+        if constexpr (adaptiveCrossover) crossoverBandit.endGeneration(currentGeneration);
+        if constexpr (adaptiveMutation) mutationBandit.endGeneration(currentGeneration);
+
+        if (asyncLocalSearch) {
+            // Fronteira de geração: entram os elites já melhorados e sai o melhor atual
+            injectLocalSearchResults();
+            if (currentGeneration % params.localSearchFreq == 0) submitLocalSearch(populationStats.bestIndex());
+        } else if (params.localSearchFreq != INT_MAX && currentGeneration % params.localSearchFreq == 0) {
+            bestIdx = populationStats.bestIndex();
+
+            double beforeLS = population.fitness(bestIdx);
+            localSearch(bestIdx);
+            double afterLS = population.fitness(bestIdx);
+            populationStats.update(bestIdx, beforeLS, afterLS);
+
+            if (afterLS < bestSolution.fitness) {
+                updateBestSolution(population.row(bestIdx), afterLS);
                 generationsWithoutImprovement = 0;
-                cout << "Geracao " << currentGeneration << ": Busca local melhorou! "
+                console() << "Geracao " << currentGeneration << ": Busca local melhorou! "
                         << beforeLS << " -> " << afterLS << endl;
             }
         }
 
-        if (params.restartGenerations != INT_MAX && generationsWithoutImprovement >= params.restartGenerations) {
-            cout << "Geracao " << currentGeneration << ": Restart acionado (sem melhoria por "
-                    << generationsWithoutImprovement << " geracoes)" << endl;
+        if (elitePort && currentGeneration % migrationInterval == 0) exchangeMigrants();
+
+        // Estagnação só regenera a população se ela convergiu nas permutações; ainda diversa, o
+        // restart espera o dobro de gerações sem melhoria
+        bool stagnated = params.restartGenerations != INT_MAX &&
+                         generationsWithoutImprovement >= params.restartGenerations;
+        if (stagnated && (diversity < params.restartDiversity ||
+                          generationsWithoutImprovement >= 2 * params.restartGenerations)) {
+            console() << "Geracao " << currentGeneration << ": Restart acionado (sem melhoria por "
+                    << generationsWithoutImprovement << " geracoes, diversidade " << diversity << ")" << endl;
             restartProcedure();
         }
 
         if (currentGeneration % 100 == 0) {
-            set<double> uniqueFit;
-            for (const auto &ind: population) {
-                uniqueFit.insert(ind.fitness);
-            }
-
-            cout << "Geracao " << currentGeneration << ":" << endl;
-            cout << "  Best=" << bestSolution.fitness
+            console() << "Geracao " << currentGeneration << ":" << endl;
+            console() << "  Best=" << bestSolution.fitness
                     << " | Avg=" << history.back().avgFitness
                     << " | Worst=" << history.back().worstFitness << endl;
-            cout << "  Fitness unicos: " << uniqueFit.size() << " / " << params.populationSize << endl;
-            cout << "  Diversidade: " << diversity << " | Temperatura: " << fixed << setprecision(2) << temperature <<
-                    endl;
-            cout << "  Operacoes: Cross=" << crossoverCount
+            console() << "  Diversidade: Hamming=" << fixed << setprecision(3) << diversityMeter.positional()
+                    << " Adjacencia=" << diversityMeter.adjacency()
+                    << " | Amplitude fitness: " << setprecision(2) << fitnessSpread << endl;
+            console() << "  Temperatura: " << temperature << endl;
+            console() << "  Operacoes: Cross=" << crossoverCount
                     << " Mut=" << mutationCount
                     << " | Subst=" << replacementCount
                     << " Forcada=" << forcedReplacementCount << endl;
-            cout << "  MutProb adaptativa: " << fixed << setprecision(3) << adaptiveMutationProb << endl;
-            cout << "  Tempo: " << elapsed.count() << "s" << endl;
+            console() << "  MutProb adaptativa: " << fixed << setprecision(3) << adaptiveMutationProb << endl;
+            if (asyncLocalSearch) console() << "  Busca local assincrona: " << localSearchInjected << " injetados" << endl;
+            if (elitePort) console() << "  Imigrantes: " << migrantsAccepted << " aceitos" << endl;
+            console() << "  Tempo: " << elapsed.count() << "s" << endl;
+        }
+
+        if (checkpointWriter && elapsed.count() - lastCheckpointTime >= params.checkpointInterval) {
+            saveCheckpoint(elapsed.count(), false);
+        }
+    }
+
+    if (asyncLocalSearch) stopLocalSearchPool();
+}
+
+// ===== STEADY-STATE ASSÍNCRONO =====
+// Cada thread seleciona dois pais da população compartilhada, gera e avalia os filhos e tenta
+// substituir o pior atual com a mesma regra de evolve (igual ou melhor, ou simulated annealing).
+// Não há barreira: as estatísticas são registradas por quem completar cada bloco de
+// populationSize filhos. Busca local e restart exigem a população parada e ficam de fora.
+
+template<typename Gene>
+template<SelectionType S>
+int GeneticAlgorithm<Gene>::selectSlot(Worker &worker) {
+    if constexpr (S == SelectionType::TOURNAMENT) {
+        int idx1 = (int) worker.rng.below(params.populationSize);
+        int idx2 = (int) worker.rng.below(params.populationSize);
+        return slots[idx1].fitness.load(memory_order_relaxed) < slots[idx2].fitness.load(memory_order_relaxed)
+                   ? idx1
+                   : idx2;
+    } else {
+        // Roleta sobre o fitness invertido lido dos atômicos (instantâneo aproximado)
+        double maxFitness = 0.0;
+        double minFitness = numeric_limits<double>::max();
+        for (int i = 0; i < params.populationSize; ++i) {
+            double f = slots[i].fitness.load(memory_order_relaxed);
+            maxFitness = max(maxFitness, f);
+            minFitness = min(minFitness, f);
+        }
+        if (maxFitness == minFitness) return (int) worker.rng.below(params.populationSize);
+
+        double totalFitness = 0.0;
+        for (int i = 0; i < params.populationSize; ++i) {
+            totalFitness += max(0.0, maxFitness - slots[i].fitness.load(memory_order_relaxed)) + 1.0;
+        }
+        double spin = worker.rng.uniform(0.0, totalFitness);
+        double cumulative = 0.0;
+        for (int i = 0; i < params.populationSize; ++i) {
+            cumulative += max(0.0, maxFitness - slots[i].fitness.load(memory_order_relaxed)) + 1.0;
+            if (cumulative >= spin) return i;
+        }
+        return params.populationSize - 1;
+    }
+}
+
+template<typename Gene>
+void GeneticAlgorithm<Gene>::copySlot(int index, Population &out, int row) {
+    slots[index].lock();
+    out.copyRow(row, population, index);
+    slots[index].unlock();
+}
+
+template<typename Gene>
+void GeneticAlgorithm<Gene>::insertSteadyState(const Population &children, int row, double temperature,
+                                               Worker &worker) {
+    double childFitness = children.fitness(row);
+
+    while (true) {
+        // Pior pelo espelho atômico, sem travar
+        int worstIdx = 0;
+        double worstFitness = slots[0].fitness.load(memory_order_relaxed);
+        for (int i = 1; i < params.populationSize; ++i) {
+            double f = slots[i].fitness.load(memory_order_relaxed);
+            if (f > worstFitness) {
+                worstFitness = f;
+                worstIdx = i;
+            }
+        }
+
+        PopulationSlot &slot = slots[worstIdx];
+        slot.lock();
+        if (population.fitness(worstIdx) != worstFitness) {
+            // Outra thread substituiu este indivíduo depois da busca: procurar de novo
+            slot.unlock();
+            continue;
+        }
+
+        bool improved = childFitness <= worstFitness;
+        bool accepted = improved || worker.rng.uniform01() < exp(-(childFitness - worstFitness) / temperature);
+        if (accepted) {
+            population.copyRow(worstIdx, children, row);
+            slot.fitness.store(childFitness, memory_order_relaxed);
         }
+        slot.unlock();
+
+        if (improved) steadyReplacements++;
+        else if (accepted) steadyForcedReplacements++;
+        break;
     }
 
-    cout << "\n========================================" << endl;
-    cout << "ALGORITMO GENETICO FINALIZADO" << endl;
-    cout << "========================================" << endl;
-    cout << "Total de geracoes: " << currentGeneration << endl;
-    cout << "Melhor fitness: " << bestSolution.fitness << endl;
-    cout << "Diversidade final (Worst-Best): " << (history.back().worstFitness - history.back().bestFitness) << endl;
-    cout << "========================================\n" << endl;
+    if (childFitness < bestFitnessSeen.load(memory_order_relaxed)) {
+        lock_guard<mutex> lock(bestMutex);
+        if (childFitness < bestSolution.fitness) {
+            updateBestSolution(children.row(row), childFitness);
+            bestFitnessSeen.store(childFitness, memory_order_relaxed);
+        }
+    }
+}
+
+template<typename Gene>
+void GeneticAlgorithm<Gene>::recordSteadyStateGeneration(long long generation, double elapsedTime) {
+    GenerationStats stats;
+    stats.generation = (int) generation;
+    stats.elapsedTime = elapsedTime;
+    stats.bestFitness = numeric_limits<double>::max();
+    stats.worstFitness = 0.0;
+
+    double sum = 0.0;
+    for (int i = 0; i < params.populationSize; ++i) {
+        double f = slots[i].fitness.load(memory_order_relaxed);
+        stats.bestFitness = min(stats.bestFitness, f);
+        stats.worstFitness = max(stats.worstFitness, f);
+        sum += f;
+    }
+    stats.avgFitness = sum / params.populationSize;
+
+    // Ao contrário de evolve, que mede a diversidade das permutações, aqui o sinal continua sendo
+    // a amplitude do fitness (Worst-Best) com os limiares antigos: os genes mudam o tempo todo
+    // sob as travas de cada slot, e medir as permutações exigiria travar a população inteira a
+    // cada geração equivalente, enquanto os fitness já estão espelhados em atômicos
+    double diversity = stats.worstFitness - stats.bestFitness;
+    double adaptiveMutationProb = params.mutationProb;
+    if (diversity < 50.0) adaptiveMutationProb = min(0.15, params.mutationProb * 3.0);
+    if (diversity < 10.0) adaptiveMutationProb = min(0.25, params.mutationProb * 5.0);
+    if (diversity < 1.0) adaptiveMutationProb = min(0.4, params.mutationProb * 10.0);
+    steadyMutationProb.store(adaptiveMutationProb, memory_order_relaxed);
+
+    lock_guard<mutex> lock(historyMutex);
+    history.push_back(stats);
+    currentGeneration = max(currentGeneration, (int) generation);
+
+    if (generation % 100 == 0) {
+        console() << "Geracao " << generation << " (steady-state):" << endl;
+        console() << "  Best=" << bestFitnessSeen.load(memory_order_relaxed)
+                << " | Avg=" << stats.avgFitness
+                << " | Worst=" << stats.worstFitness << endl;
+        console() << "  Subst=" << steadyReplacements.exchange(0)
+                << " Forcada=" << steadyForcedReplacements.exchange(0) << endl;
+        console() << "  Tempo: " << elapsedTime << "s" << endl;
+    }
+}
+
+template<typename Gene>
+template<SelectionType S, CrossoverType C, MutationType M>
+void GeneticAlgorithm<Gene>::steadyStateWorker(int w, chrono::high_resolution_clock::time_point startTime) {
+    constexpr bool adaptive = C == CrossoverType::ADAPTIVE || M == MutationType::ADAPTIVE;
+
+    // Linhas 0 e 1 do scratch recebem os pais copiados da população, 2 e 3 os filhos
+    Worker &worker = workers[w];
+    Population &scratch = worker.scratch;
+
+    while (!stopSteadyState.load(memory_order_relaxed)) {
+        chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - startTime;
+        double generation = (double) childrenProduced.load(memory_order_relaxed) / params.populationSize;
+        if (elapsed.count() >= params.maxCPUTimeSeconds ||
+            (params.maxGenerations > 0 && generation >= params.maxGenerations)) {
+            stopSteadyState.store(true);
+            break;
+        }
+
+        double temperature = max(1.0, 50.0 * (1.0 - coolingProgress(elapsed.count(), generation)));
+
+        copySlot(selectSlot<S>(worker), scratch, 0);
+        copySlot(selectSlot<S>(worker), scratch, 1);
+        breedPair<C, M>(scratch, 0, 1, steadyMutationProb.load(memory_order_relaxed), scratch, 2, worker);
+
+        if constexpr (adaptive) {
+            lock_guard<mutex> lock(banditMutex);
+            crossoverBandit.usage().merge(worker.crossoverUsage);
+            mutationBandit.usage().merge(worker.mutationUsage);
+            worker.crossoverUsage.reset(crossoverBandit.size());
+            worker.mutationUsage.reset(mutationBandit.size());
+        }
+
+        for (int child: {2, 3}) {
+            insertSteadyState(scratch, child, temperature, worker);
+
+            long long produced = childrenProduced.fetch_add(1) + 1;
+            if (produced % params.populationSize == 0) {
+                long long generation = produced / params.populationSize;
+                recordSteadyStateGeneration(generation, elapsed.count());
+
+                if constexpr (adaptive) {
+                    lock_guard<mutex> lock(banditMutex);
+                    if (C == CrossoverType::ADAPTIVE) crossoverBandit.endGeneration((int) generation);
+                    if (M == MutationType::ADAPTIVE) mutationBandit.endGeneration((int) generation);
+                }
+            }
+        }
+    }
+}
+
+template<typename Gene>
+template<SelectionType S, CrossoverType C, MutationType M>
+void GeneticAlgorithm<Gene>::evolveSteadyState(chrono::high_resolution_clock::time_point startTime) {
+    slots.reset(new PopulationSlot[params.populationSize]);
+    for (int i = 0; i < params.populationSize; ++i) {
+        slots[i].fitness.store(population.fitness(i), memory_order_relaxed);
+    }
+    stopSteadyState.store(false);
+    childrenProduced.store((long long) currentGeneration * params.populationSize); // > 0 na retomada
+    steadyMutationProb.store(params.mutationProb);
+    bestFitnessSeen.store(bestSolution.fitness);
+    steadyReplacements.store(0);
+    steadyForcedReplacements.store(0);
+
+    // Threads dedicadas (a thread atual é o worker 0): cada uma roda até o tempo acabar
+    // e imprime no mesmo console da instância
+    vector<thread> threads;
+    ostream &out = console();
+    for (int w = 1; w < (int) workers.size(); ++w) {
+        threads.emplace_back([this, w, startTime, &out] {
+            ConsoleScope scope(out);
+            resetThreadAffinity();
+            steadyStateWorker<S, C, M>(w, startTime);
+        });
+    }
+    steadyStateWorker<S, C, M>(0, startTime);
+    for (auto &t: threads) {
+        t.join();
+    }
+
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - startTime;
+    console() << "\nTempo maximo atingido: " << elapsed.count() << "s" << endl;
+
+    // Blocos concluídos fora de ordem por threads diferentes
+    stable_sort(history.begin(), history.end(), [](const GenerationStats &a, const GenerationStats &b) {
+        return a.generation < b.generation;
+    });
+}
+
+template<typename Gene>
+template<SelectionType S, CrossoverType C>
+void GeneticAlgorithm<Gene>::dispatchMutation(chrono::high_resolution_clock::time_point startTime) {
+    if (params.steadyState) {
+        switch (params.mutationType) {
+            case MutationType::INTERCHANGE: return evolveSteadyState<S, C, MutationType::INTERCHANGE>(startTime);
+            case MutationType::SWAP: return evolveSteadyState<S, C, MutationType::SWAP>(startTime);
+            case MutationType::ADAPTIVE: return evolveSteadyState<S, C, MutationType::ADAPTIVE>(startTime);
+            default: return evolveSteadyState<S, C, MutationType::INSERT>(startTime);
+        }
+    }
+
+    switch (params.mutationType) {
+        case MutationType::INTERCHANGE: return evolve<S, C, MutationType::INTERCHANGE>(startTime);
+        case MutationType::SWAP: return evolve<S, C, MutationType::SWAP>(startTime);
+        case MutationType::ADAPTIVE: return evolve<S, C, MutationType::ADAPTIVE>(startTime);
+        default: return evolve<S, C, MutationType::INSERT>(startTime);
+    }
+}
+
+template<typename Gene>
+template<SelectionType S>
+void GeneticAlgorithm<Gene>::dispatchCrossover(chrono::high_resolution_clock::time_point startTime) {
+    switch (params.crossoverType) {
+        case CrossoverType::PMX: return dispatchMutation<S, CrossoverType::PMX>(startTime);
+        case CrossoverType::SB2OX: return dispatchMutation<S, CrossoverType::SB2OX>(startTime);
+        case CrossoverType::OPX: return dispatchMutation<S, CrossoverType::OPX>(startTime);
+        case CrossoverType::TPX: return dispatchMutation<S, CrossoverType::TPX>(startTime);
+        case CrossoverType::ADAPTIVE: return dispatchMutation<S, CrossoverType::ADAPTIVE>(startTime);
+        default: return dispatchMutation<S, CrossoverType::OBX>(startTime);
+    }
+}
+
+template<typename Gene>
+void GeneticAlgorithm<Gene>::dispatchEvolution(chrono::high_resolution_clock::time_point startTime) {
+    if (params.selectionType == SelectionType::ROULETTE_WHEEL) {
+        dispatchCrossover<SelectionType::ROULETTE_WHEEL>(startTime);
+    } else {
+        dispatchCrossover<SelectionType::TOURNAMENT>(startTime);
+    }
+}
+
+template<typename Gene>
+Individual GeneticAlgorithm<Gene>::runWithSeed(const vector<int> &seedChromosome) {
+    auto startTime = chrono::high_resolution_clock::now();
+
+    console() << "\n========================================" << endl;
+    console() << "INICIANDO ALGORITMO GENETICO (COM SEED)" << endl;
+    console() << "========================================" << endl;
+    console() << "Selecao: " << selectionTypeToString(params.selectionType) << endl;
+    console() << "Crossover: " << crossoverTypeToString(params.crossoverType) << endl;
+    console() << "Mutacao: " << mutationTypeToString(params.mutationType) << endl;
+    console() << "Populacao: " << params.populationSize << endl;
+    console() << "Prob. Crossover: " << params.crossoverProb << endl;
+    console() << "Prob. Mutacao: " << params.mutationProb << endl;
+    console() << "Threads: " << params.numThreads << (params.steadyState ? " (steady-state assincrono)" : "") << endl;
+    if (params.localSearchThreads > 0 && !params.steadyState)
+        console() << "Busca local: " << params.localSearchThreads << " thread(s) em segundo plano" << endl;
+    console() << "Genes: " << sizeof(Gene) << " byte(s) por job" << endl;
+    console() << "========================================\n" << endl;
+
+    initializeWorkers();
+
+    bool checkpointing = !params.checkpointFile.empty() && params.checkpointInterval > 0.0;
+    if (checkpointing && params.resume && loadCheckpoint()) {
+        // O relógio continua de onde parou: --time é o orçamento total da instância
+        startTime -= chrono::duration_cast<chrono::high_resolution_clock::duration>(
+            chrono::duration<double>(resumedTime));
+        console() << "Retomado do checkpoint: geracao " << currentGeneration << ", " << resumedTime
+                << "s, best=" << bestSolution.fitness << endl;
+    } else {
+        runFromScratch(seedChromosome, startTime);
+    }
+
+    if (checkpointing) {
+        checkpointWriter.reset(new CheckpointWriter(params.checkpointFile));
+        lastCheckpointTime = resumedTime;
+    }
+
+    dispatchEvolution(startTime);
+
+    if (checkpointing) {
+        // Checkpoint final: retomar uma instância concluída não gasta mais tempo de busca
+        saveCheckpoint(chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count(), true);
+        console() << "Checkpoints gravados: " << checkpointWriter->written()
+                << " (descartados com o disco ocupado: " << checkpointWriter->skipped() << ")" << endl;
+        checkpointWriter.reset();
+    }
+
+    console() << "\n========================================" << endl;
+    console() << "ALGORITMO GENETICO FINALIZADO" << endl;
+    console() << "========================================" << endl;
+    console() << "Total de geracoes: " << currentGeneration << endl;
+    console() << "Melhor fitness: " << bestSolution.fitness << endl;
+    console() << "Diversidade final (Worst-Best): " << (history.back().worstFitness - history.back().bestFitness) << endl;
+    console() << "========================================\n" << endl;
 
     return bestSolution;
 }
 
+template<typename Gene>
+void GeneticAlgorithm<Gene>::runFromScratch(const vector<int> &seedChromosome,
+                                            chrono::high_resolution_clock::time_point startTime) {
+    initializePopulationWithSeed(seedChromosome);
+    evaluatePopulation();
 
-Individual GeneticAlgorithm::run() {
+    auto elapsed0 = chrono::high_resolution_clock::now() - startTime;
+    recordGenerationStats(chrono::duration<double>(elapsed0).count());
+
+    console() << "Populacao inicial avaliada:" << endl;
+    console() << "  Best: " << history[0].bestFitness << endl;
+    console() << "  Avg:  " << history[0].avgFitness << endl;
+    console() << "  Worst:" << history[0].worstFitness << endl;
+
+    set<double> uniqueFitness(population.allFitness().begin(), population.allFitness().end());
+    console() << "  Fitness unicos: " << uniqueFitness.size() << " / " << params.populationSize << endl;
+
+    console() << "\nPrimeiros 5 cromossomos:" << endl;
+    for (int i = 0; i < min(5, population.size()); ++i) {
+        console() << "  [" << i << "] Fitness=" << population.fitness(i) << " Chr=[";
+        for (int j = 0; j < min(10, numGenes); ++j) {
+            console() << (int) population.row(i)[j];
+            if (j < min(10, numGenes) - 1) console() << ",";
+        }
+        console() << "...]" << endl;
+    }
+    console() << endl;
+
+    currentGeneration = 0;
+}
+
+
+template<typename Gene>
+Individual GeneticAlgorithm<Gene>::run() {
     vector<int> emptyChromosome;
     return runWithSeed(emptyChromosome);
 }
 
+template<typename Gene>
+void GeneticAlgorithm<Gene>::saveOperatorLog(const string &outputFile) const {
+    bool adaptiveCrossover = params.crossoverType == CrossoverType::ADAPTIVE;
+    bool adaptiveMutation = params.mutationType == MutationType::ADAPTIVE;
+    if (!adaptiveCrossover && !adaptiveMutation) return;
+
+    ofstream file(outputFile);
+    if (!file.is_open()) {
+        cerr << "ERRO: Nao foi possivel criar log de operadores!" << endl;
+        return;
+    }
+
+    OperatorBandit::writeLogHeader(file);
+    if (adaptiveCrossover) crossoverBandit.writeLog(file, "Crossover");
+    if (adaptiveMutation) mutationBandit.writeLog(file, "Mutation");
+}
+
+// Tipos de gene escolhidos por withGeneType
+template class GeneticAlgorithm<uint8_t>;
+template class GeneticAlgorithm<uint16_t>;
+template class GeneticAlgorithm<int32_t>;
+
 string selectionTypeToString(SelectionType type) {
     switch (type) {
         case SelectionType::TOURNAMENT: return "Tournament";
@@ -999,6 +1589,7 @@ string crossoverTypeToString(CrossoverType type) {
         case CrossoverType::SB2OX: return "SB2OX";
         case CrossoverType::OPX: return "OPX";
         case CrossoverType::TPX: return "TPX";
+        case CrossoverType::ADAPTIVE: return "Adaptive";
         default: return "Unknown";
     }
 }
@@ -1008,6 +1599,7 @@ string mutationTypeToString(MutationType type) {
         case MutationType::INSERT: return "Insert";
         case MutationType::INTERCHANGE: return "Interchange";
         case MutationType::SWAP: return "Swap";
+        case MutationType::ADAPTIVE: return "Adaptive";
         default: return "Unknown";
     }
 }
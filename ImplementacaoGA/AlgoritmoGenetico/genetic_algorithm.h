@@ -2,9 +2,24 @@
 #define GENETIC_ALGORITHM_H
 
 #include "../scheduling_ga.h"
-#include <random>
+#include "operator_bandit.h"
+#include "thread_pool.h"
+#include "population_stats.h"
+#include "crossover_kernels.h"
+#include "population_matrix.h"
+#include "permutation_moves.h"
+#include "population_diversity.h"
+#include "checkpoint.h"
+#include "console.h"
+#include "random_stream.h"
+#include "elite_port.h"
 #include <chrono>
 #include <set>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <condition_variable>
 
 using namespace std;
 
@@ -20,14 +35,16 @@ enum class CrossoverType
     PMX,
     SB2OX,
     OPX,
-    TPX
+    TPX,
+    ADAPTIVE // Escolhe entre os cinco acima durante a execução (OperatorBandit)
 };
 
 enum class MutationType
 {
     INSERT,
     INTERCHANGE,
-    SWAP
+    SWAP,
+    ADAPTIVE // Escolhe entre os três acima durante a execução (OperatorBandit)
 };
 
 struct GAParameters
@@ -40,9 +57,17 @@ struct GAParameters
     double crossoverProb;
     double mutationProb;
     int restartGenerations;
+    double restartDiversity; // Diversidade de permutações abaixo da qual a estagnação dispara o restart
     int localSearchFreq;
     int localSearchIntensity;
     double maxCPUTimeSeconds;
+    int maxGenerations; // Limite de gerações (0 = só o tempo); com ele a execução é reprodutível pela semente
+    int numThreads; // Threads para cruzar e avaliar os filhos de cada geração
+    bool steadyState; // Steady-state assíncrono em vez de gerações sincronizadas
+    int localSearchThreads; // Threads de busca local em segundo plano (0 = busca local dentro da geração)
+    string checkpointFile; // Checkpoint binário da execução (vazio = sem checkpoints)
+    double checkpointInterval; // Segundos entre checkpoints periódicos
+    bool resume; // Continuar de checkpointFile, se existir e for compatível
 
     GAParameters()
         : selectionType(SelectionType::TOURNAMENT),
@@ -52,11 +77,19 @@ struct GAParameters
           crossoverProb(0.95),
           mutationProb(0.03),
           restartGenerations(50),
+          restartDiversity(0.10),
           localSearchFreq(10),
           localSearchIntensity(1),
-          maxCPUTimeSeconds(60.0) {}
+          maxCPUTimeSeconds(60.0),
+          maxGenerations(0),
+          numThreads(1),
+          steadyState(false),
+          localSearchThreads(0),
+          checkpointInterval(30.0),
+          resume(false) {}
 };
 
+// Solução devolvida pelo GA (a população em si fica numa PopulationMatrix)
 struct Individual
 {
     vector<int> chromosome;
@@ -81,61 +114,226 @@ struct GenerationStats
     double elapsedTime;
 };
 
+// Contexto de uma thread de reprodução: RNG próprio e cópia dos dados do problema usada pelo
+// decodificador (que altera máquinas e jobs durante a simulação)
+template<typename Gene>
+struct GAWorker
+{
+    RandomStream rng;
+    ProblemData problemData;
+    vector<int> decodeBuffer;      // Cromossomo convertido para 1-based
+    CrossoverMarks marks;          // Marcadores dos kernels de crossover
+    PopulationMatrix<Gene> scratch; // Linhas de trabalho: pais/filhos do steady-state e busca local
+
+    // Operador sorteado na última chamada adaptativa e créditos da geração
+    int lastCrossoverArm;
+    int lastMutationArm;
+    OperatorUsage crossoverUsage;
+    OperatorUsage mutationUsage;
+
+    // Contadores da geração para o relatório
+    int crossoverCount;
+    int mutationCount;
+
+    GAWorker() : lastCrossoverArm(0), lastMutationArm(0), crossoverCount(0), mutationCount(0) {}
+};
+
+// Gene é o tipo inteiro dos genes na população (uint8_t, uint16_t ou int32_t, ver withGeneType).
+// As três instâncias são explícitas em genetic_algorithm.cpp.
+template<typename Gene>
 class GeneticAlgorithm
 {
 private:
+    using Worker = GAWorker<Gene>;
+    using Population = PopulationMatrix<Gene>;
+
     GAParameters params;
     ProblemData problemData;
-    vector<Individual> population;
+    int numGenes;
+    Population population;
+    PopulationStats populationStats; // Pior, melhor e soma de population, mantidos a cada troca
+    PermutationDiversity<Gene> diversityMeter; // Distâncias entre cromossomos, medida a cada geração
     Individual bestSolution;
     int currentGeneration;
     int generationsWithoutImprovement;
-    mt19937 rng;
+    RandomStream rng;
 
     // Histórico de gerações
     vector<GenerationStats> history;
 
+    // Seleção adaptativa (CrossoverType::ADAPTIVE / MutationType::ADAPTIVE)
+    OperatorBandit crossoverBandit;
+    OperatorBandit mutationBandit;
+
+    // Reprodução em paralelo: workers[0] também é usado por todo o código sequencial
+    vector<Worker> workers;
+    unique_ptr<ThreadPool> threadPool;
+    vector<int> matingPool;       // Índices dos pais da geração em population
+    vector<double> rouletteCumulative; // Soma prefixa da roleta da geração
+    Population offspring;         // Filhos da geração, na ordem dos pares do mating pool
+    Population restartBuffer;     // População ordenada montada pelo restart
+
+    // Steady-state assíncrono: cada indivíduo da população é protegido pela sua própria trava,
+    // e o fitness fica espelhado num atômico para que seleção e busca do pior não travem nada
+    struct alignas(64) PopulationSlot
+    {
+        atomic<double> fitness;
+        atomic_flag busy = ATOMIC_FLAG_INIT;
+
+        void lock()
+        {
+            while (busy.test_and_set(memory_order_acquire)) this_thread::yield();
+        }
+        void unlock() { busy.clear(memory_order_release); }
+    };
+    unique_ptr<PopulationSlot[]> slots;
+    atomic<bool> stopSteadyState;
+    atomic<long long> childrenProduced; // Uma "geração" equivale a populationSize filhos
+    atomic<double> steadyMutationProb;  // Taxa adaptada pela diversidade a cada geração equivalente
+    atomic<double> bestFitnessSeen;
+    atomic<int> steadyReplacements;
+    atomic<int> steadyForcedReplacements;
+    mutex bestMutex;    // Protege bestSolution
+    mutex historyMutex; // Protege history e o estado por geração
+    mutex banditMutex;  // Protege os acumuladores dos bandits
+
+    // Busca local assíncrona (localSearchThreads > 0): elites entram em localSearchQueue, threads
+    // próprias os melhoram com a vizinhança de inserção e os resultados esperam em
+    // localSearchResults até a próxima fronteira de geração. O laço principal nunca espera por elas.
+    struct LocalSearchJob
+    {
+        vector<Gene> chromosome;
+        double fitness;
+    };
+    vector<Worker> localSearchWorkers;
+    vector<thread> localSearchPool;
+    deque<LocalSearchJob> localSearchQueue;
+    vector<LocalSearchJob> localSearchResults;
+    mutex localSearchMutex; // Protege a fila e os resultados
+    condition_variable localSearchReady;
+    atomic<bool> stopLocalSearch;
+    int localSearchInjected;
+
+    // Checkpoints: o laço monta o estado no buffer do writer, que grava em segundo plano
+    unique_ptr<CheckpointWriter> checkpointWriter;
+    double lastCheckpointTime; // Tempo de busca do último checkpoint, em segundos
+    double resumedTime;        // Tempo de busca já gasto antes da retomada
+
+    // Troca de elites (setElitePort): a cada migrationInterval gerações o melhor sai pela porta e
+    // os imigrantes que chegaram entram no lugar dos piores
+    ElitePort *elitePort;
+    int migrationInterval;
+    int migrantsAccepted;
+    Population migrantBuffer; // Imigrante convertido para genes 0-based e reavaliado
+
+    const atomic<int> *threadLimit; // Teto de threads do pool (setThreadLimit)
+
     void initializePopulation();
     void initializePopulationWithSeed(const vector<int> &seedChromosome);
-    void evaluateIndividual(Individual &ind);
+    void initializeWorkers();
+    double evaluate(const Gene *chromosome, Worker &worker);
     void evaluatePopulation();
     void recordGenerationStats(double elapsedTime);
+    void updateBestSolution(const Gene *chromosome, double fitness);
 
-    vector<Individual> tournamentSelection();
-    vector<Individual> rouletteWheelSelection();
-    vector<Individual> performSelection();
+    // Seleção preenche matingPool com índices de population; os pais são lidos direto da matriz
+    void tournamentSelection();
+    void rouletteWheelSelection();
+    template<SelectionType S>
+    void performSelection();
 
-    pair<Individual, Individual> orderBasedCrossover(const Individual &p1, const Individual &p2);
-    pair<Individual, Individual> partialMappedCrossover(const Individual &p1, const Individual &p2);
-    pair<Individual, Individual> similarBlock2PointCrossover(const Individual &p1, const Individual &p2);
-    pair<Individual, Individual> onePointOrderCrossover(const Individual &p1, const Individual &p2);
-    pair<Individual, Individual> twoPointOrderCrossover(const Individual &p1, const Individual &p2);
-    pair<Individual, Individual> performCrossover(const Individual &p1, const Individual &p2);
+    // Crossovers escrevem os dois filhos em linhas já alocadas
+    void orderBasedCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, Worker &worker);
+    void partialMappedCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, Worker &worker);
+    void similarBlock2PointCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, Worker &worker);
+    void onePointOrderCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, Worker &worker);
+    void twoPointOrderCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, Worker &worker);
+    void crossoverWithArm(int arm, const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, Worker &worker);
+    template<CrossoverType C>
+    void performCrossover(const Gene *p1, const Gene *p2, Gene *child1, Gene *child2, Worker &worker);
 
-    void insertMutation(Individual &ind);
-    void interchangeMutation(Individual &ind);
-    void swapMutation(Individual &ind);
-    void performMutation(Individual &ind);
+    void insertMutation(Gene *chromosome, Worker &worker);
+    void interchangeMutation(Gene *chromosome, Worker &worker);
+    void swapMutation(Gene *chromosome, Worker &worker);
+    void mutationWithArm(int arm, Gene *chromosome, Worker &worker);
+    template<MutationType M>
+    void performMutation(Gene *chromosome, Worker &worker);
+    void performMutation(Gene *chromosome);
 
-    void localSearch(Individual &ind);
+    void localSearch(int index);
+    void improveByInsertion(Worker &worker);
+    void startLocalSearchPool();
+    void stopLocalSearchPool();
+    void localSearchWorkerLoop(int w);
+    void submitLocalSearch(int index);
+    void injectLocalSearchResults();
+    void exchangeMigrants();
+    void saveCheckpoint(double elapsedTime, bool wait);
+    bool loadCheckpoint();
     void restartProcedure();
-    void halfGenesMutation(Individual &ind);
+    void halfGenesMutation(Gene *chromosome);
+    // Fração da execução para o resfriamento: pelas gerações se limitadas, senão pelo tempo
+    double coolingProgress(double elapsedSeconds, double generation) const;
 
-    bool isDuplicate(const Individual &ind);
+    bool isDuplicate(const Population &source, int row);
     int getWorstIndex();
-    void replaceWorst(const Individual &child);
+    void replaceIndividual(int index, const Population &source, int row);
+    void rebuildPopulationStats();
+    void replaceWorst(const Population &source, int row);
+
+    // Cruza, muta e avalia as linhas parent1 e parent2 de parents nas linhas child e child + 1
+    // de children
+    template<CrossoverType C, MutationType M>
+    void breedPair(const Population &parents, int parent1, int parent2, double mutationProb,
+                   Population &children, int child, Worker &worker);
+
+    // Laço principal instanciado para a combinação de operadores escolhida
+    template<SelectionType S, CrossoverType C, MutationType M>
+    void evolve(chrono::high_resolution_clock::time_point startTime);
+    template<SelectionType S, CrossoverType C>
+    void dispatchMutation(chrono::high_resolution_clock::time_point startTime);
+    template<SelectionType S>
+    void dispatchCrossover(chrono::high_resolution_clock::time_point startTime);
+    void dispatchEvolution(chrono::high_resolution_clock::time_point startTime);
+    // População inicial (seed + aleatórios) avaliada e registrada como geração 0
+    void runFromScratch(const vector<int> &seedChromosome, chrono::high_resolution_clock::time_point startTime);
+
+    // Steady-state assíncrono: threads sem barreira entre gerações
+    template<SelectionType S, CrossoverType C, MutationType M>
+    void evolveSteadyState(chrono::high_resolution_clock::time_point startTime);
+    template<SelectionType S, CrossoverType C, MutationType M>
+    void steadyStateWorker(int w, chrono::high_resolution_clock::time_point startTime);
+    template<SelectionType S>
+    int selectSlot(Worker &worker);
+    void copySlot(int index, Population &out, int row);
+    void insertSteadyState(const Population &children, int row, double temperature, Worker &worker);
+    void recordSteadyStateGeneration(long long generation, double elapsedTime);
 
 public:
     GeneticAlgorithm(const GAParameters &p, const ProblemData &data);
 
+    // Fluxo principal (--seed), antes de run/runWithSeed; sem chamar, a semente vem do random_device
+    void setRandomStream(const RandomStream &stream);
+
+    // Liga o GA geracional a outros solvers: ilhas em outros processos (MigrationLink, já em
+    // beginRun() desta execução) ou o PSO do portfólio (SharedIncumbent). O steady-state não migra
+    void setElitePort(ElitePort *port, int interval);
+
+    // Teto de threads lido a cada laço paralelo; o pool continua com params.numThreads contextos
+    void setThreadLimit(const atomic<int> *limit) { threadLimit = limit; }
+
     Individual run();
     Individual runWithSeed(const vector<int> &seedChromosome);
 
     Individual getBestSolution() const { return bestSolution; }
     int getCurrentGeneration() const { return currentGeneration; }
+    double getResumedTime() const { return resumedTime; }
 
     int getGenerationsExecuted() const { return static_cast<int>(history.size()); }
     vector<GenerationStats> getHistory() const { return history; }
+
+    // Log por geração dos operadores adaptativos; não escreve nada se nenhum for ADAPTIVE
+    void saveOperatorLog(const string &outputFile) const;
 };
 
 string selectionTypeToString(SelectionType type);
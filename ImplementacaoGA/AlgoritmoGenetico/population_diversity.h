@@ -0,0 +1,123 @@
+#ifndef POPULATION_DIVERSITY_H
+#define POPULATION_DIVERSITY_H
+
+#include "population_matrix.h"
+#include "random_stream.h"
+#include <bit>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Número de posições em que a e b diferem
+template<typename Gene>
+inline int countMismatches(const Gene *a, const Gene *b, int n)
+{
+    int mismatches = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        mismatches += a[i] != b[i];
+    }
+    return mismatches;
+}
+
+// Genes de 1 byte: 32 (AVX2) ou 16 (SSE2) comparações por instrução e popcount da máscara
+template<>
+inline int countMismatches<uint8_t>(const uint8_t *a, const uint8_t *b, int n)
+{
+    int equalCount = 0;
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        equalCount += popcount((uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+    }
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(__AVX2__)
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        equalCount += popcount((uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        equalCount += a[i] == b[i];
+    }
+    return n - equalCount;
+}
+
+// Diversidade da população medida nas permutações, não no fitness: dois cromossomos bem
+// diferentes podem ter o mesmo makespan. Sobre uma amostra de pares mede
+//  - distância posicional: fração de posições com genes diferentes (Hamming);
+//  - distância de adjacência: fração de genes cujo sucessor difere entre os dois.
+// A segunda também é um Hamming, entre os vetores de sucessores, então as duas usam countMismatches.
+// Ambas ficam perto de 1 para permutações aleatórias e chegam a 0 com a população convergida.
+template<typename Gene>
+class PermutationDiversity
+{
+public:
+    void seed(uint64_t seedValue) { rng.seed(seedValue); }
+
+    // Fluxo da amostragem de pares, salvo no checkpoint: ele decide a taxa de mutação adaptativa
+    const RandomStream &sampler() const { return rng; }
+    void restoreSampler(const RandomStream &state) { rng = state; }
+
+    void measure(const PopulationMatrix<Gene> &population, int numPairs)
+    {
+        int size = population.size();
+        int n = population.length();
+        numPairs = min(numPairs, size * (size - 1) / 2);
+        if (numPairs <= 0 || n == 0)
+        {
+            positionalDistance = adjacencyDistance = 0.0;
+            return;
+        }
+
+        // successors.row(i)[g] = gene depois de g no indivíduo i (n para o último, cabe em Gene)
+        successors.resize(size, n);
+        for (int i = 0; i < size; ++i)
+        {
+            const Gene *chromosome = population.row(i);
+            Gene *next = successors.row(i);
+            for (int k = 0; k + 1 < n; ++k)
+            {
+                next[chromosome[k]] = chromosome[k + 1];
+            }
+            next[chromosome[n - 1]] = (Gene) n;
+        }
+
+        long long positional = 0;
+        long long adjacency = 0;
+        for (int p = 0; p < numPairs; ++p)
+        {
+            int a = (int) rng.below(size);
+            int b = (int) rng.below(size);
+            while (b == a) b = (int) rng.below(size);
+
+            positional += countMismatches(population.row(a), population.row(b), n);
+            adjacency += countMismatches(successors.row(a), successors.row(b), n);
+        }
+
+        positionalDistance = (double) positional / ((double) numPairs * n);
+        adjacencyDistance = (double) adjacency / ((double) numPairs * n);
+    }
+
+    double positional() const { return positionalDistance; }
+    double adjacency() const { return adjacencyDistance; }
+    double combined() const { return 0.5 * (positionalDistance + adjacencyDistance); }
+
+private:
+    PopulationMatrix<Gene> successors;
+    RandomStream rng;
+    double positionalDistance = 1.0;
+    double adjacencyDistance = 1.0;
+};
+
+#endif
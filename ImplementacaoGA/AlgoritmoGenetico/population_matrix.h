@@ -0,0 +1,90 @@
+#ifndef POPULATION_MATRIX_H
+#define POPULATION_MATRIX_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+// População guardada como uma única matriz contígua (linha = cromossomo 0-based) com o fitness
+// num vetor paralelo. Gene é o menor inteiro que comporta os índices dos jobs (ver
+// withGeneType), então 2000 indivíduos de 100 jobs ocupam um bloco de 200 KB em vez de
+// 2000 vetores de 400 bytes espalhados pelo heap.
+template<typename Gene>
+class PopulationMatrix
+{
+public:
+    void resize(int rows, int length)
+    {
+        numRows = rows;
+        rowLength = length;
+        genes.resize((size_t) rows * length);
+        fitnessValues.assign(rows, numeric_limits<double>::max());
+    }
+
+    int size() const { return numRows; }
+    int length() const { return rowLength; }
+
+    Gene *row(int index) { return genes.data() + (size_t) index * rowLength; }
+    const Gene *row(int index) const { return genes.data() + (size_t) index * rowLength; }
+
+    double &fitness(int index) { return fitnessValues[index]; }
+    double fitness(int index) const { return fitnessValues[index]; }
+    const vector<double> &allFitness() const { return fitnessValues; }
+
+    // Copia genes e fitness da linha from de source para a linha index
+    void copyRow(int index, const PopulationMatrix &source, int from)
+    {
+        copy(source.row(from), source.row(from) + rowLength, row(index));
+        fitnessValues[index] = source.fitnessValues[from];
+    }
+
+    void assignRow(int index, const vector<int> &chromosome)
+    {
+        copy(chromosome.begin(), chromosome.end(), row(index));
+        fitnessValues[index] = numeric_limits<double>::max();
+    }
+
+    void setRow(int index, const Gene *chromosome, double fitness)
+    {
+        copy(chromosome, chromosome + rowLength, row(index));
+        fitnessValues[index] = fitness;
+    }
+
+    vector<int> rowToVector(int index) const
+    {
+        return vector<int>(row(index), row(index) + rowLength);
+    }
+
+    bool rowsEqual(int index, const PopulationMatrix &other, int otherIndex) const
+    {
+        return equal(row(index), row(index) + rowLength, other.row(otherIndex));
+    }
+
+    void swap(PopulationMatrix &other)
+    {
+        genes.swap(other.genes);
+        fitnessValues.swap(other.fitnessValues);
+        std::swap(numRows, other.numRows);
+        std::swap(rowLength, other.rowLength);
+    }
+
+private:
+    vector<Gene> genes;
+    vector<double> fitnessValues;
+    int numRows = 0;
+    int rowLength = 0;
+};
+
+// Chama fn com um valor do menor tipo de gene capaz de indexar numJobs jobs
+template<typename Fn>
+decltype(auto) withGeneType(int numJobs, Fn &&fn)
+{
+    if (numJobs <= numeric_limits<uint8_t>::max()) return fn(uint8_t());
+    if (numJobs <= numeric_limits<uint16_t>::max()) return fn(uint16_t());
+    return fn(int32_t());
+}
+
+#endif
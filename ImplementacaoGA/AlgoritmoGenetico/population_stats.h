@@ -0,0 +1,126 @@
+#ifndef POPULATION_STATS_H
+#define POPULATION_STATS_H
+
+#include <vector>
+#include <functional>
+
+using namespace std;
+
+// Heap indexado sobre valores por índice: topo em O(1) e troca do valor de um índice em O(log n).
+// Empates são resolvidos pelo menor índice, como o primeiro encontrado numa varredura linear.
+template<typename Compare>
+class IndexedHeap
+{
+public:
+    void build(const vector<double> &values)
+    {
+        key = values;
+        int n = (int) key.size();
+        heap.resize(n);
+        position.resize(n);
+        for (int i = 0; i < n; ++i)
+        {
+            heap[i] = i;
+            position[i] = i;
+        }
+        for (int slot = n / 2 - 1; slot >= 0; --slot)
+        {
+            siftDown(slot);
+        }
+    }
+
+    int top() const { return heap[0]; }
+    double topValue() const { return key[heap[0]]; }
+
+    void update(int index, double value)
+    {
+        key[index] = value;
+        siftUp(position[index]);
+        siftDown(position[index]);
+    }
+
+private:
+    vector<int> heap;     // heap[slot] = índice
+    vector<int> position; // position[índice] = slot
+    vector<double> key;
+    Compare compare;
+
+    // a fica acima de b no heap
+    bool above(int a, int b) const
+    {
+        if (key[a] != key[b]) return compare(key[a], key[b]);
+        return a < b;
+    }
+
+    void swapSlots(int s1, int s2)
+    {
+        swap(heap[s1], heap[s2]);
+        position[heap[s1]] = s1;
+        position[heap[s2]] = s2;
+    }
+
+    void siftUp(int slot)
+    {
+        while (slot > 0)
+        {
+            int parent = (slot - 1) / 2;
+            if (!above(heap[slot], heap[parent])) break;
+            swapSlots(slot, parent);
+            slot = parent;
+        }
+    }
+
+    void siftDown(int slot)
+    {
+        int n = (int) heap.size();
+        while (true)
+        {
+            int best = slot;
+            int left = 2 * slot + 1;
+            int right = left + 1;
+            if (left < n && above(heap[left], heap[best])) best = left;
+            if (right < n && above(heap[right], heap[best])) best = right;
+            if (best == slot) break;
+            swapSlots(slot, best);
+            slot = best;
+        }
+    }
+};
+
+// Estatísticas da população mantidas incrementalmente: pior e melhor por heaps indexados e
+// soma corrente para a média. Cada substituição custa O(log P) em vez de varrer a população.
+class PopulationStats
+{
+public:
+    void build(const vector<double> &fitness)
+    {
+        worstHeap.build(fitness);
+        bestHeap.build(fitness);
+        sum = 0.0;
+        for (double f : fitness) sum += f;
+        count = (int) fitness.size();
+    }
+
+    void update(int index, double oldFitness, double newFitness)
+    {
+        sum += newFitness - oldFitness;
+        worstHeap.update(index, newFitness);
+        bestHeap.update(index, newFitness);
+    }
+
+    int worstIndex() const { return worstHeap.top(); }
+    int bestIndex() const { return bestHeap.top(); }
+    double worst() const { return worstHeap.topValue(); }
+    double best() const { return bestHeap.topValue(); }
+    double average() const { return sum / count; }
+
+private:
+    IndexedHeap<greater<double>> worstHeap;
+    IndexedHeap<less<double>> bestHeap;
+    // O fitness é o atraso total, inteiro porque tempos de processamento e due dates são
+    // inteiros, então a soma incremental não acumula erro
+    double sum = 0.0;
+    int count = 0;
+};
+
+#endif
@@ -1,11 +1,22 @@
 #include "scheduling_ga.h"
 #include "AlgoritmoGenetico/genetic_algorithm.h"
+#include "parallel_tempering.h"
+#include "batch_runner.h"
+#include "task_runtime.h"
+#include "replication_stats.h"
+#include "random_stream.h"
+#include "batch_budget.h"
+#include "benchmark_manifest.h"
+#include "results_store.h"
+#include "migration_link.h"
+#include "portfolio.h"
 #include <filesystem>
 #include <chrono>
 #include <iomanip>
 #include <cmath>
 #include <numeric>
 #include <algorithm>
+#include <climits>
 
 namespace fs = std::filesystem;
 using namespace std::chrono;
@@ -47,6 +58,9 @@ struct InstanceResult
     // Solução
     string bestChromosome;
     string gaConfig;
+
+    // Execução independente da instância (1..R com --replications R)
+    int replication;
 };
 
 // Calcular métricas expandidas
@@ -149,7 +163,39 @@ void saveGenerationHistory(const string &outputDir, const string &instanceName,
     file.close();
 }
 
-void saveSummaryResults(const string &outputDir, const vector<InstanceResult> &results)
+// Linha do summary_GA_*.csv; é também o que o armazém de resultados guarda de cada execução
+string formatSummaryRow(const InstanceResult &result)
+{
+    stringstream row;
+    row << result.instanceFile << ","
+        << result.permutationFile << ","
+        << result.nJobs << ","
+        << result.nStages << ","
+        << fixed << setprecision(4)
+        << result.initialFitness << ","
+        << result.bestFitness << ","
+        << result.worstFitness << ","
+        << result.avgFitness << ","
+        << result.stdDev << ","
+        << result.finalFitness << ","
+        << result.improvement << ","
+        << result.rpd << ","
+        << result.executionTimeMs << ","
+        << result.timePerGenMs << ","
+        << result.populationSize << ","
+        << result.generations << ","
+        << result.convergenceGen << ","
+        << result.convergencePercent << ","
+        << result.fitnessDiversity << ","
+        << result.bestChromosome << ","
+        << result.gaConfig << ","
+        << result.replication;
+    return row.str();
+}
+
+// Resumo do lote como vista do armazém: uma linha por execução encontrada nele, na ordem do lote.
+// fileTag identifica o shard (--shard) no nome do arquivo, para o merge_shards.py
+void saveSummaryResults(const string &outputDir, const vector<const StoredResult *> &records, const string &fileTag)
 {
     fs::create_directories(outputDir);
 
@@ -157,7 +203,7 @@ void saveSummaryResults(const string &outputDir, const vector<InstanceResult> &r
     auto timestamp = system_clock::to_time_t(now);
 
     stringstream filename;
-    filename << outputDir << "\\summary_GA_" << timestamp << ".csv";
+    filename << outputDir << "\\summary_GA_" << timestamp << fileTag << ".csv";
 
     ofstream file(filename.str());
     if (!file.is_open())
@@ -170,38 +216,98 @@ void saveSummaryResults(const string &outputDir, const vector<InstanceResult> &r
     file << "Instance,Permutation,Jobs,Stages,InitialFitness,BestFitness,WorstFitness,"
          << "AvgFitness,StdDev,FinalFitness,Improvement(%),RPD(%),ExecutionTime_ms,"
          << "TimePerGen_ms,PopSize,Generations,ConvergenceGen,ConvergencePercent(%),"
-         << "FitnessDiversity,BestChromosome,GAConfig\n";
+         << "FitnessDiversity,BestChromosome,GAConfig,Replication\n";
 
-    for (const auto &result : results)
+    for (const StoredResult *record : records)
     {
-        file << result.instanceFile << ","
-             << result.permutationFile << ","
-             << result.nJobs << ","
-             << result.nStages << ","
-             << fixed << setprecision(4)
-             << result.initialFitness << ","
-             << result.bestFitness << ","
-             << result.worstFitness << ","
-             << result.avgFitness << ","
-             << result.stdDev << ","
-             << result.finalFitness << ","
-             << result.improvement << ","
-             << result.rpd << ","
-             << result.executionTimeMs << ","
-             << result.timePerGenMs << ","
-             << result.populationSize << ","
-             << result.generations << ","
-             << result.convergenceGen << ","
-             << result.convergencePercent << ","
-             << result.fitnessDiversity << ","
-             << result.bestChromosome << ","
-             << result.gaConfig << "\n";
+        if (record)
+            file << record->summaryRow << "\n";
     }
 
     file.close();
     cout << "\nResumo salvo em: " << filename.str() << endl;
 }
 
+// Estatísticas entre as replicações de cada instância, a partir do armazém; records tem uma posição
+// por execução (nullptr = sem resultado), com as replicações de uma instância em posições consecutivas
+void saveReplicationSummary(const string &outputDir, const vector<const StoredResult *> &records, int replications,
+                            const string &fileTag)
+{
+    auto timestamp = system_clock::to_time_t(system_clock::now());
+
+    stringstream filename;
+    filename << outputDir << "\\replications_GA_" << timestamp << fileTag << ".csv";
+
+    ofstream file(filename.str());
+    if (!file.is_open())
+    {
+        cerr << "ERRO: Nao foi possivel criar resumo das replicacoes!" << endl;
+        return;
+    }
+    writeReplicationHeader(file);
+
+    cout << "\nReplicacoes por instancia (" << replications << " execucoes):" << endl;
+    for (size_t first = 0; first < records.size(); first += replications)
+    {
+        vector<ReplicationRun> instanceRuns;
+        const StoredResult *reference = nullptr;
+        for (int r = 0; r < replications; ++r)
+        {
+            if (!records[first + r]) continue;
+            instanceRuns.push_back(records[first + r]->run);
+            reference = records[first + r];
+        }
+        if (!reference) continue;
+
+        ReplicationSummary summary = summarizeReplications(instanceRuns);
+        writeReplicationRow(file, reference->key.instance, reference->jobs, reference->stages, summary,
+                            reference->config);
+
+        cout << "  " << reference->key.instance << ": Best=" << fixed << setprecision(2) << summary.bestFitness
+             << " Media=" << summary.meanFitness << " Mediana=" << summary.medianFitness
+             << " Desvio=" << summary.stdDev << " | Ate a media: " << summary.timeToMeanMs << " ms ("
+             << summary.runsReachingMean << "/" << summary.runs << ")" << endl;
+    }
+
+    file.close();
+    cout << "Resumo das replicacoes salvo em: " << filename.str() << endl;
+}
+
+// Descrição canônica de tudo que muda o resultado de uma execução (sem semente, threads nem
+// diretórios): a chave de configuração do armazém de resultados
+string gaConfigKey(const string &engine, const GAParameters &gaParams, const TemperingParameters &temperingParams,
+                   const PortfolioPSOSettings &psoSettings, double batchBudget, int defaultDueDate, int remotePeers, int migrationInterval)
+{
+    stringstream key;
+    key << setprecision(17) << "engine=" << engine << ";duedate=" << defaultDueDate;
+    if (batchBudget > 0.0)
+        key << ";budget=" << batchBudget;
+    else
+        key << ";time=" << gaParams.maxCPUTimeSeconds;
+    key << ";generations=" << gaParams.maxGenerations;
+    if (engine == "tempering")
+    {
+        key << ";replicas=" << temperingParams.numReplicas << ";tmin=" << temperingParams.minTemperature
+            << ";tmax=" << temperingParams.maxTemperature << ";sweeps=" << temperingParams.sweepsPerRound;
+    }
+    else
+    {
+        key << ";selection=" << selectionTypeToString(gaParams.selectionType)
+            << ";crossover=" << crossoverTypeToString(gaParams.crossoverType)
+            << ";mutation=" << mutationTypeToString(gaParams.mutationType)
+            << ";pop=" << gaParams.populationSize << ";pc=" << gaParams.crossoverProb
+            << ";pm=" << gaParams.mutationProb << ";restart=" << gaParams.restartGenerations
+            << ";restartdiv=" << gaParams.restartDiversity << ";lsfreq=" << gaParams.localSearchFreq
+            << ";lsintensity=" << gaParams.localSearchIntensity << ";steady=" << gaParams.steadyState
+            << ";asyncls=" << (gaParams.localSearchThreads > 0);
+        if (remotePeers > 0)
+            key << ";remote=" << remotePeers << ";migint=" << migrationInterval;
+        if (engine == "portfolio")
+            key << ";psopop=" << psoSettings.populationSize << ";threads=" << gaParams.numThreads;
+    }
+    return key.str();
+}
+
 void printUsage(const char *programName)
 {
     cout << "\n==================================================================" << endl;
@@ -214,15 +320,41 @@ void printUsage(const char *programName)
     cout << "  --duedate <valor>     Due date padrao" << endl;
     cout << "\nOPCOES DO GA:" << endl;
     cout << "  --selection <tipo>    tournament | roulette" << endl;
-    cout << "  --crossover <tipo>    obx | pmx | sb2ox | opx | tpx" << endl;
-    cout << "  --mutation <tipo>     insert | interchange | swap" << endl;
+    cout << "  --crossover <tipo>    obx | pmx | sb2ox | opx | tpx | adaptive" << endl;
+    cout << "  --mutation <tipo>     insert | interchange | swap | adaptive" << endl;
     cout << "  --popsize <n>         30 | 70 | 110 | 150" << endl;
     cout << "  --pc <valor>          0.8 | 0.95 | 1.0" << endl;
     cout << "  --pm <valor>          0.00 | 0.03 | 0.05" << endl;
     cout << "  --restart <gens>      30 | 50 | inf" << endl;
+    cout << "  --restart-diversity <d>  Diversidade (0-1) abaixo da qual a estagnacao reinicia (padrao: 0.10)" << endl;
     cout << "  --lsfreq <gens>       5 | 10 | inf" << endl;
     cout << "  --lsintensity <f>     1 | 5" << endl;
     cout << "  --time <segundos>     Tempo maximo por instancia" << endl;
+    cout << "\nLOTE PELO MANIFESTO (benchmark_index.txt):" << endl;
+    cout << "  --manifest <arquivo>  Manifesto (padrao: benchmark_index.txt ao lado de --instances)" << endl;
+    cout << "  --class <lista>       Classes de tamanho, ex.: P,M (padrao: todas)" << endl;
+    cout << "  --min-jobs <n>        Apenas instancias com pelo menos n jobs" << endl;
+    cout << "  --max-jobs <n>        Apenas instancias com no maximo n jobs" << endl;
+    cout << "  --shard <k/N>         Fatia k de N do lote filtrado, para dividir entre processos" << endl;
+    cout << "  --budget <segundos>   Tempo total do lote, dividido pelo tamanho das instancias (substitui --time)" << endl;
+    cout << "  --generations <n>     Limite de geracoes por instancia (padrao: 0 = so o tempo)" << endl;
+    cout << "  --seed <s>            Semente; com --generations a execucao e reprodutivel (padrao: aleatoria)" << endl;
+    cout << "  --threads <n>         Threads para cruzar e avaliar os filhos (padrao: 1)" << endl;
+    cout << "  --steady-state        GA steady-state assincrono, sem barreira entre geracoes" << endl;
+    cout << "  --ls-threads <n>      Threads de busca local em segundo plano (padrao: 0 = na geracao)" << endl;
+    cout << "  --island-listen <end>     Endereco deste processo para ilhas remotas: unix:<caminho> ou tcp:<host>:<porta>" << endl;
+    cout << "  --island-peers <lista>    Enderecos (separados por virgula) que recebem os elites deste processo" << endl;
+    cout << "  --migration-interval <n>  Geracoes entre migracoes com as ilhas remotas (padrao: 10)" << endl;
+    cout << "  --engine <tipo>       ga | tempering | portfolio (GA e PSO com um incumbente comum) (padrao: ga)" << endl;
+    cout << "  --pso-popsize <n>     Particulas do PSO no portfolio (padrao: 100)" << endl;
+    cout << "  --replicas <n>        Replicas do parallel tempering (padrao: 8)" << endl;
+    cout << "  --jobs <n>            Instancias resolvidas em paralelo (padrao: 1, ou as replicacoes)" << endl;
+    cout << "  --replications <r>    Execucoes independentes por instancia, com resumo entre elas (padrao: 1)" << endl;
+    cout << "  --workers <n>         Threads do runtime compartilhado por instancias e lacos (padrao: nucleos)" << endl;
+    cout << "  --pin-threads         Fixa cada thread do runtime em um nucleo" << endl;
+    cout << "  --checkpoint-interval <s>  Segundos entre checkpoints do GA (padrao: 30, 0 = desligado)" << endl;
+    cout << "  --recompute           Refaz execucoes ja presentes em <output>/results_GA.store" << endl;
+    cout << "  --resume              Continua cada instancia do seu checkpoint em <output>" << endl;
     cout << "\nEXEMPLO:" << endl;
     cout << "  " << programName << " --instances ./Instancias --permutations ./Permutacoes --output ./Resultados" << endl;
     cout << "==================================================================\n"
@@ -238,6 +370,46 @@ int main(int argc, char *argv[])
 
     GAParameters gaParams;
 
+    // Motor: "ga" ou "tempering" (parallel tempering com o mesmo decodificador e operadores)
+    string engine = "ga";
+    TemperingParameters temperingParams;
+
+    // Portfólio: o PSO discreto roda junto com o GA e os dois dividem as --threads
+    PortfolioPSOSettings psoSettings;
+
+    // Instâncias resolvidas ao mesmo tempo (cada uma ainda usa --threads threads)
+    int numJobs = 1;
+    bool jobsSet = false;
+
+    // Execuções independentes por instância; sem --jobs, as replicações rodam em paralelo
+    int replications = 1;
+
+    // Threads do runtime de tarefas (0 = núcleos da máquina), configuradas uma vez para todo o
+    // processo: --jobs e --threads limitam o paralelismo, mas não criam threads
+    int numWorkers = 0;
+    bool pinThreads = false;
+
+    // Semente base: cada replicação usa o seu fluxo (replicationStream); sem --seed é sorteada e
+    // impressa, para que a execução possa ser repetida
+    uint64_t seed = 0;
+    bool seedSet = false;
+
+    // Tempo de parede do lote inteiro (0 = --time fixo por instância)
+    double batchBudget = 0.0;
+
+    // Execuções já gravadas no armazém de resultados são puladas, a menos que --recompute
+    bool recompute = false;
+
+    // Ilhas em outros processos: este escuta em islandListen e envia os elites para islandPeers
+    string islandListen;
+    vector<string> islandPeers;
+    int migrationInterval = 10;
+
+    // Lote pelo manifesto: qualquer filtro (ou --manifest) troca a varredura do diretório pela
+    // lista do benchmark_index.txt
+    string manifestPath;
+    ManifestFilter manifestFilter;
+
     for (int i = 1; i < argc; i++)
     {
         string arg = argv[i];
@@ -279,6 +451,8 @@ int main(int argc, char *argv[])
                 gaParams.crossoverType = CrossoverType::OPX;
             else if (value == "tpx")
                 gaParams.crossoverType = CrossoverType::TPX;
+            else if (value == "adaptive")
+                gaParams.crossoverType = CrossoverType::ADAPTIVE;
         }
         else if (arg == "--mutation" && i + 1 < argc)
         {
@@ -289,11 +463,66 @@ int main(int argc, char *argv[])
                 gaParams.mutationType = MutationType::INTERCHANGE;
             else if (value == "swap")
                 gaParams.mutationType = MutationType::SWAP;
+            else if (value == "adaptive")
+                gaParams.mutationType = MutationType::ADAPTIVE;
         }
         else if (arg == "--popsize" && i + 1 < argc)
         {
             gaParams.populationSize = stoi(argv[++i]);
         }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            gaParams.numThreads = max(1, stoi(argv[++i]));
+        }
+        else if (arg == "--steady-state")
+        {
+            gaParams.steadyState = true;
+        }
+        else if (arg == "--ls-threads" && i + 1 < argc)
+        {
+            gaParams.localSearchThreads = max(0, stoi(argv[++i]));
+        }
+        else if (arg == "--engine" && i + 1 < argc)
+        {
+            engine = argv[++i];
+        }
+        else if (arg == "--pso-popsize" && i + 1 < argc)
+        {
+            psoSettings.populationSize = max(2, stoi(argv[++i]));
+        }
+        else if (arg == "--replicas" && i + 1 < argc)
+        {
+            temperingParams.numReplicas = max(2, stoi(argv[++i]));
+        }
+        else if (arg == "--jobs" && i + 1 < argc)
+        {
+            numJobs = max(1, stoi(argv[++i]));
+            jobsSet = true;
+        }
+        else if (arg == "--replications" && i + 1 < argc)
+        {
+            replications = max(1, stoi(argv[++i]));
+        }
+        else if (arg == "--workers" && i + 1 < argc)
+        {
+            numWorkers = stoi(argv[++i]);
+        }
+        else if (arg == "--pin-threads")
+        {
+            pinThreads = true;
+        }
+        else if (arg == "--checkpoint-interval" && i + 1 < argc)
+        {
+            gaParams.checkpointInterval = stod(argv[++i]);
+        }
+        else if (arg == "--resume")
+        {
+            gaParams.resume = true;
+        }
+        else if (arg == "--recompute")
+        {
+            recompute = true;
+        }
         else if (arg == "--pc" && i + 1 < argc)
         {
             gaParams.crossoverProb = stod(argv[++i]);
@@ -310,6 +539,10 @@ int main(int argc, char *argv[])
             else
                 gaParams.restartGenerations = stoi(value);
         }
+        else if (arg == "--restart-diversity" && i + 1 < argc)
+        {
+            gaParams.restartDiversity = stod(argv[++i]);
+        }
         else if (arg == "--lsfreq" && i + 1 < argc)
         {
             string value = argv[++i];
@@ -326,6 +559,55 @@ int main(int argc, char *argv[])
         {
             gaParams.maxCPUTimeSeconds = stod(argv[++i]);
         }
+        else if (arg == "--manifest" && i + 1 < argc)
+        {
+            manifestPath = argv[++i];
+        }
+        else if (arg == "--class" && i + 1 < argc)
+        {
+            manifestFilter.classes = parseClassList(argv[++i]);
+        }
+        else if (arg == "--min-jobs" && i + 1 < argc)
+        {
+            manifestFilter.minJobs = stoi(argv[++i]);
+        }
+        else if (arg == "--max-jobs" && i + 1 < argc)
+        {
+            manifestFilter.maxJobs = stoi(argv[++i]);
+        }
+        else if (arg == "--shard" && i + 1 < argc)
+        {
+            if (!parseShard(argv[++i], manifestFilter.shardIndex, manifestFilter.shardCount))
+            {
+                cerr << "ERRO: --shard espera k/N com 1 <= k <= N" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--budget" && i + 1 < argc)
+        {
+            batchBudget = stod(argv[++i]);
+        }
+        else if (arg == "--generations" && i + 1 < argc)
+        {
+            gaParams.maxGenerations = max(0, stoi(argv[++i]));
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            seed = stoull(argv[++i]);
+            seedSet = true;
+        }
+        else if (arg == "--island-listen" && i + 1 < argc)
+        {
+            islandListen = argv[++i];
+        }
+        else if (arg == "--island-peers" && i + 1 < argc)
+        {
+            islandPeers = parseAddressList(argv[++i]);
+        }
+        else if (arg == "--migration-interval" && i + 1 < argc)
+        {
+            migrationInterval = max(1, stoi(argv[++i]));
+        }
         else if (arg == "--help" || arg == "-h")
         {
             printUsage(argv[0]);
@@ -340,58 +622,213 @@ int main(int argc, char *argv[])
     cout << "Permutacoes:  " << permutationsDir << endl;
     cout << "Resultados:   " << outputDir << endl;
     cout << "Due Date:     " << defaultDueDate << endl;
+    // Processos vizinhos trocam elites da mesma instância: uma execução por vez
+    MigrationLink remoteLink;
+    if (!islandListen.empty())
+    {
+        if (engine != "ga" || gaParams.steadyState)
+        {
+            cerr << "ERRO: --island-listen requer o GA geracional (sem --engine tempering ou --steady-state)" << endl;
+            return 1;
+        }
+        if (!remoteLink.start(islandListen, islandPeers))
+            return 1;
+        numJobs = 1;
+        jobsSet = true;
+    }
+
+    if (engine == "portfolio" && gaParams.steadyState)
+    {
+        cerr << "ERRO: --engine portfolio usa o GA geracional (sem --steady-state)" << endl;
+        return 1;
+    }
+
+    TaskRuntime::configure(numWorkers, pinThreads);
+    int runtimeThreads = TaskRuntime::instance().size();
+    if (!jobsSet && replications > 1)
+    {
+        numJobs = min(replications, runtimeThreads);
+    }
+
+    cout << "Motor:        " << engine << endl;
+    cout << "Jobs:         " << numJobs << endl;
+    if (remoteLink.isRunning())
+        cout << "Ilhas remotas: escuta em " << islandListen << ", envia para " << islandPeers.size()
+             << " processo(s) a cada " << migrationInterval << " geracoes" << endl;
+    cout << "Workers:      " << runtimeThreads << (pinThreads ? " (fixos em nucleos)" : "") << endl;
+    if (replications > 1)
+        cout << "Replicacoes:  " << replications << endl;
+
+    // Armazém de resultados do diretório de saída; sem --seed, um lote interrompido retoma com a
+    // semente da última execução gravada com a mesma configuração
+    fs::create_directories(outputDir);
+    ResultsStore store((fs::path(outputDir) / "results_GA.store").string());
+    string algorithm = (engine == "tempering") ? "PT" : (engine == "portfolio") ? "PF" : "GA";
+    uint64_t configHash = hashConfig(gaConfigKey(engine, gaParams, temperingParams, psoSettings, batchBudget,
+                                                 defaultDueDate, remoteLink.isRunning() ? (int) islandPeers.size() : 0,
+                                                 migrationInterval));
+    bool seedFromStore = !seedSet && store.latestSeed(algorithm, configHash, seed);
+    if (!seedSet && !seedFromStore)
+        seed = randomSeed();
+    cout << "Semente:      " << seed << (seedSet ? "" : seedFromStore ? " (do armazem)" : " (aleatoria)") << endl;
+    cout << "Armazem:      " << store.getPath() << " (" << store.size() << " resultados";
+    if (store.discardedLines() > 0)
+        cout << ", " << store.discardedLines() << " linhas corrompidas ignoradas";
+    cout << ")" << endl;
+    if (gaParams.maxGenerations > 0)
+        cout << "Geracoes:     " << gaParams.maxGenerations << endl;
+    if (batchBudget > 0.0)
+        cout << "Orcamento:    " << batchBudget << " s para o lote (proporcional ao tamanho)" << endl;
+    else
+        cout << "Tempo:        " << gaParams.maxCPUTimeSeconds << " s por instancia" << endl;
     cout << "============================================================\n"
          << endl;
 
     vector<string> instanceFiles;
-    for (const auto &entry : fs::directory_iterator(instancesDir))
+    map<string, string> manifestPermutations; // Instância -> permutação indicada no manifesto
+    bool useManifest = !manifestPath.empty() || manifestFilter.active();
+    if (manifestPath.empty())
+        manifestPath = defaultManifestPath(instancesDir);
+
+    if (useManifest)
+    {
+        vector<ManifestEntry> entries = readManifest(manifestPath);
+        if (entries.empty())
+        {
+            cerr << "ERRO: Manifesto vazio ou nao encontrado: " << manifestPath << endl;
+            return 1;
+        }
+        for (const ManifestEntry &entry : selectEntries(entries, manifestFilter))
+        {
+            if (!fs::exists(fs::path(instancesDir) / entry.instanceFile))
+            {
+                cout << "AVISO: " << entry.instanceFile << " esta no manifesto mas nao em " << instancesDir << endl;
+                continue;
+            }
+            instanceFiles.push_back(entry.instanceFile);
+            manifestPermutations[entry.instanceFile] = entry.permutationFile;
+        }
+        cout << "Manifesto:    " << manifestPath << " (" << instanceFiles.size() << " de " << entries.size()
+             << " instancias";
+        if (manifestFilter.shardCount > 1)
+            cout << ", shard " << manifestFilter.shardIndex << "/" << manifestFilter.shardCount;
+        cout << ")" << endl;
+    }
+    else
     {
-        if (entry.path().extension() == ".txt")
+        for (const auto &entry : fs::directory_iterator(instancesDir))
         {
-            instanceFiles.push_back(entry.path().filename().string());
+            if (entry.path().extension() == ".txt")
+            {
+                instanceFiles.push_back(entry.path().filename().string());
+            }
         }
+
+        sort(instanceFiles.begin(), instanceFiles.end(), [](const string &a, const string &b)
+             {
+            int numA = stoi(a.substr(1, a.find('.') - 1));
+            int numB = stoi(b.substr(1, b.find('.') - 1));
+            return numA < numB; });
     }
 
-    sort(instanceFiles.begin(), instanceFiles.end(), [](const string &a, const string &b)
-         {
-        int numA = stoi(a.substr(1, a.find('.') - 1));
-        int numB = stoi(b.substr(1, b.find('.') - 1));
-        return numA < numB; });
+    // Parâmetros comuns a todas as instâncias, fixados antes do lote: mesmo orçamento de tempo
+    // e threads do GA para o parallel tempering
+    temperingParams.numThreads = gaParams.numThreads;
+    temperingParams.maxSeconds = gaParams.maxCPUTimeSeconds;
+    temperingParams.maxRounds = gaParams.maxGenerations;
+    fs::create_directories(outputDir);
 
-    vector<InstanceResult> results;
+    // Uma tarefa por execução (instância x replicação), até numJobs ao mesmo tempo; cada uma
+    // escreve só na sua posição
     int total = instanceFiles.size();
-    int processed = 0;
+    int numRuns = total * replications;
+    vector<char> solved(numRuns, 0);
 
-    for (const auto &instanceFile : instanceFiles)
+    // Chave de cada execução no armazém; só as ausentes (ou todas, com --recompute) entram no lote
+    vector<ResultKey> runKeys(numRuns);
+    vector<int> pendingRuns;
+    for (int i = 0; i < numRuns; ++i)
     {
-        processed++;
+        runKeys[i] = {algorithm, instanceFiles[i / replications], configHash, seed, i % replications + 1};
+        if (recompute || !store.find(runKeys[i]))
+            pendingRuns.push_back(i);
+    }
+    if ((int) pendingRuns.size() < numRuns)
+        cout << "Ja no armazem: " << numRuns - (int) pendingRuns.size() << " de " << numRuns
+             << " execucoes (puladas)\n" << endl;
+
+    // Com --budget, as execuções começam da maior instância para a menor e cada uma recebe sua
+    // fatia do tempo restante ao começar
+    unique_ptr<BudgetScheduler> budget;
+    if (batchBudget > 0.0)
+    {
+        vector<double> fileWeights = instanceWeights(manifestPath, instancesDir, instanceFiles);
+        vector<double> runWeights;
+        for (int index : pendingRuns)
+            runWeights.push_back(fileWeights[index / replications]);
+        budget = make_unique<BudgetScheduler>(batchBudget, numJobs, runWeights);
+    }
+
+    runBatch((int) pendingRuns.size(), numJobs, [&](int slot)
+    {
+        int pending = budget ? budget->order()[slot] : slot;
+        int index = pendingRuns[pending];
+        double timeLimit = budget ? budget->acquire(pending) : gaParams.maxCPUTimeSeconds;
+
+        const string &instanceFile = instanceFiles[index / replications];
+        int processed = index / replications + 1;
+        int replication = index % replications + 1;
+
+        // Arquivos por execução ganham o sufixo _r<k> quando há replicações
+        string runSuffix = (replications > 1) ? "_r" + to_string(replication) : "";
 
         int instanceId = stoi(instanceFile.substr(1, instanceFile.find('.') - 1));
         fs::path instancePath = fs::path(instancesDir) / instanceFile;
-        string permutationFile = "P" + to_string(instanceId) + ".txt";
+        auto manifestPermutation = manifestPermutations.find(instanceFile);
+        string permutationFile = (manifestPermutation != manifestPermutations.end())
+                                     ? manifestPermutation->second
+                                     : "P" + to_string(instanceId) + ".txt";
         fs::path permutationPath = fs::path(permutationsDir) / permutationFile;
 
-        cout << "\n[" << processed << "/" << total << "] Processando " << instanceFile << endl;
-        cout << "-------------------------------------------------------------" << endl;
+        console() << "\n[" << processed << "/" << total << "] Processando " << instanceFile;
+        if (replications > 1)
+            console() << " (replicacao " << replication << "/" << replications << ")";
+        console() << endl;
+        console() << "-------------------------------------------------------------" << endl;
+
+        // Orçamento do lote esgotado: os solvers leem tempo 0 como "sem limite", então a execução
+        // fica para a próxima sessão (o armazém a mantém pendente)
+        if (budget && timeLimit <= 0.0)
+        {
+            console() << "AVISO: Orcamento do lote esgotado, execucao pulada" << endl;
+            budget->release(pending, 0.0);
+            return;
+        }
 
         if (!fs::exists(permutationPath))
         {
-            cout << "AVISO: Permutacao " << permutationFile << " nao encontrada! Pulando..." << endl;
-            continue;
+            console() << "AVISO: Permutacao " << permutationFile << " nao encontrada! Pulando..." << endl;
+            if (budget)
+                budget->release(pending, 0.0);
+            return;
         }
 
         ProblemData problem;
         if (!readInstanceFromFile(instancePath.string(), problem, defaultDueDate))
         {
-            cout << "ERRO ao ler instancia!" << endl;
-            continue;
+            console() << "ERRO ao ler instancia!" << endl;
+            if (budget)
+                budget->release(pending, 0.0);
+            return;
         }
 
         vector<int> seedPermutation;
         if (!readPermutationFromFile(permutationPath.string(), seedPermutation))
         {
-            cout << "ERRO ao ler permutacao!" << endl;
-            continue;
+            console() << "ERRO ao ler permutacao!" << endl;
+            if (budget)
+                budget->release(pending, 0.0);
+            return;
         }
 
         // Converter para 0-based
@@ -405,24 +842,94 @@ int main(int argc, char *argv[])
         ProblemData dataCopy = problem;
         double initialFitness = decodeChromosome(seedPermutation, dataCopy);
 
-        cout << "Fitness inicial (seed): " << fixed << setprecision(2) << initialFitness << endl;
+        console() << "Fitness inicial (seed): " << fixed << setprecision(2) << initialFitness << endl;
+        if (budget)
+            console() << "Fatia do orcamento: " << timeLimit << " s" << endl;
 
         // Executar GA
         auto start = high_resolution_clock::now();
 
-        GeneticAlgorithm ga(gaParams, problem);
-        Individual bestSolution = ga.runWithSeed(seedChromosome);
+        // Genes com o menor tipo inteiro que comporta os jobs da instância
+        string instanceName = instanceFile.substr(0, instanceFile.find('.'));
+        Individual bestSolution;
+        vector<GenerationStats> history;
+        high_resolution_clock::time_point end;
+        double resumedSeconds = 0.0; // Tempo de busca de sessões anteriores, vindo do checkpoint
+        if (engine == "tempering")
+        {
+            // Cada rodada conta como uma geração
+            TemperingParameters runParams = temperingParams;
+            runParams.maxSeconds = timeLimit;
+            ParallelTempering<ProblemData> tempering(runParams, problem);
+            tempering.setRandomStream(replicationStream(seed, replication - 1));
+            bestSolution.chromosome = tempering.run(seedChromosome);
+            bestSolution.fitness = tempering.getBestFitness();
+            end = high_resolution_clock::now();
+            for (const TemperingStats &stats : tempering.getHistory())
+            {
+                history.push_back({stats.round, stats.bestFitness, stats.avgFitness, stats.worstFitness,
+                                   stats.elapsedTime});
+            }
+        }
+        else if (engine == "portfolio")
+        {
+            GAParameters instanceParams = gaParams;
+            instanceParams.maxCPUTimeSeconds = timeLimit;
+            PortfolioResult portfolio = runPortfolio(instanceParams, psoSettings, problem, instancePath.string(),
+                                                     defaultDueDate, seedChromosome,
+                                                     replicationStream(seed, replication - 1));
+            end = high_resolution_clock::now();
+            bestSolution = portfolio.best;
+            history = portfolio.history;
+            console() << "Portfolio: melhorias do incumbente GA=" << portfolio.gaImprovements
+                      << " PSO=" << portfolio.psoImprovements << " | threads no fim GA=" << portfolio.gaThreads
+                      << " PSO=" << portfolio.psoThreads << endl;
+        }
+        else
+        {
+            // Um checkpoint por instância no diretório de saída
+            GAParameters instanceParams = gaParams;
+            instanceParams.maxCPUTimeSeconds = timeLimit;
+            if (gaParams.checkpointInterval > 0.0)
+            {
+                instanceParams.checkpointFile =
+                    (fs::path(outputDir) / ("checkpoint_" + instanceName + runSuffix + ".bin")).string();
+            }
+
+            withGeneType(problem.numJobs, [&](auto gene)
+            {
+                GeneticAlgorithm<decltype(gene)> ga(instanceParams, problem);
+                ga.setRandomStream(replicationStream(seed, replication - 1));
+                if (remoteLink.isRunning())
+                {
+                    // Só os processos na mesma instância e replicação trocam elites com esta execução
+                    remoteLink.beginRun(migrationTag(instanceFile, replication));
+                    ga.setElitePort(&remoteLink, migrationInterval);
+                }
+                bestSolution = ga.runWithSeed(seedChromosome);
+                end = high_resolution_clock::now();
+                resumedSeconds = ga.getResumedTime();
+                history = ga.getHistory();
+                ga.saveOperatorLog((fs::path(outputDir) / ("operators_" + instanceName + runSuffix + ".csv")).string());
+            });
+            if (remoteLink.isRunning())
+                console() << "Ilhas remotas: " << remoteLink.framesSent() << " elites enviados, "
+                          << remoteLink.framesReceived() << " recebidos (total do processo)" << endl;
+        }
+
+        // O que sobrou da fatia (ex.: parou pelo limite de gerações) volta para as próximas execuções
+        if (budget)
+            budget->release(pending, std::chrono::duration<double>(end - start).count());
 
-        auto end = high_resolution_clock::now();
-        auto duration = duration_cast<milliseconds>(end - start);
+        auto duration = duration_cast<milliseconds>(end - start) +
+                        duration_cast<milliseconds>(std::chrono::duration<double>(resumedSeconds));
 
         // ✅ Obter número real de gerações
-        int actualGenerations = ga.getGenerationsExecuted();
+        int actualGenerations = static_cast<int>(history.size());
 
 
         // Salvar histórico de gerações
-        string instanceName = instanceFile.substr(0, instanceFile.find('.'));
-        saveGenerationHistory(outputDir, instanceName, ga.getHistory(), gaParams);
+        saveGenerationHistory(outputDir, instanceName + runSuffix, history, gaParams);
 
         // Formatar cromossomo como string
         stringstream chromosomeStr;
@@ -437,12 +944,25 @@ int main(int argc, char *argv[])
 
         // Formatar configuração do GA
         stringstream configStr;
-        configStr << selectionTypeToString(gaParams.selectionType) << "|"
-                  << crossoverTypeToString(gaParams.crossoverType) << "|"
-                  << mutationTypeToString(gaParams.mutationType) << "|"
-                  << "Pop:" << gaParams.populationSize << "|"
-                  << "Pc:" << gaParams.crossoverProb << "|"
-                  << "Pm:" << gaParams.mutationProb;
+        if (engine == "tempering")
+            configStr << "PT|R:" << temperingParams.numReplicas << "|"
+                      << "T:" << temperingParams.minTemperature << "-" << temperingParams.maxTemperature;
+        else
+        {
+            if (engine == "portfolio")
+                configStr << "PF|";
+            configStr << selectionTypeToString(gaParams.selectionType) << "|"
+                      << crossoverTypeToString(gaParams.crossoverType) << "|"
+                      << mutationTypeToString(gaParams.mutationType) << "|"
+                      << "Pop:" << gaParams.populationSize << "|"
+                      << "Pc:" << gaParams.crossoverProb << "|"
+                      << "Pm:" << gaParams.mutationProb;
+            if (engine == "portfolio")
+                configStr << "|PSOPop:" << psoSettings.populationSize;
+        }
+        if (remoteLink.isRunning())
+            configStr << "|Peers:" << islandPeers.size();
+        configStr << "|Seed:" << seed;
 
         InstanceResult result;
         result.instanceFile = instanceFile;
@@ -452,33 +972,59 @@ int main(int argc, char *argv[])
         result.initialFitness = initialFitness;
         result.bestChromosome = chromosomeStr.str();
         result.gaConfig = configStr.str();
+        result.replication = replication;
 
         // Calcular métricas expandidas
-        calculateExpandedMetrics(result, bestSolution, ga.getHistory(),
-                                 duration.count(), gaParams.populationSize,
+        int populationSize = (engine == "tempering") ? temperingParams.numReplicas : gaParams.populationSize;
+        calculateExpandedMetrics(result, bestSolution, history,
+                                 duration.count(), populationSize,
                                  actualGenerations);
 
-        results.push_back(result);
-
-        cout << "\nResultado:" << endl;
-        cout << "  Fitness inicial: " << result.initialFitness << endl;
-        cout << "  Fitness final:   " << result.finalFitness << endl;
-        cout << "  Melhoria:        " << fixed << setprecision(2) << result.improvement << "%" << endl;
-        cout << "  Tempo:           " << result.executionTimeMs << " ms" << endl;
-        cout << "  Convergencia:    " << result.convergenceGen << " geracoes" << endl;
-        cout << "  ✅ Gerações:      " << actualGenerations << endl;  
-        cout << "-------------------------------------------------------------" << endl;
-    }
-
-    saveSummaryResults(outputDir, results);
+        solved[index] = 1;
+
+        // Gravado assim que termina: uma interrupção depois daqui não perde esta execução
+        StoredResult stored;
+        stored.key = runKeys[index];
+        stored.jobs = result.nJobs;
+        stored.stages = result.nStages;
+        stored.config = result.gaConfig;
+        stored.summaryRow = formatSummaryRow(result);
+        stored.run = {result.finalFitness, result.executionTimeMs, bestFitnessCurve(history)};
+        if (!store.append(stored))
+            console() << "AVISO: Falha ao gravar no armazem de resultados" << endl;
+
+        console() << "\nResultado:" << endl;
+        console() << "  Fitness inicial: " << result.initialFitness << endl;
+        console() << "  Fitness final:   " << result.finalFitness << endl;
+        console() << "  Melhoria:        " << fixed << setprecision(2) << result.improvement << "%" << endl;
+        console() << "  Tempo:           " << result.executionTimeMs << " ms" << endl;
+        console() << "  Convergencia:    " << result.convergenceGen << " geracoes" << endl;
+        console() << "  ✅ Gerações:      " << actualGenerations << endl;  
+        console() << "-------------------------------------------------------------" << endl;
+    });
+
+    // Resumos do lote inteiro (inclusive execuções de sessões anteriores), lidos do armazém
+    vector<const StoredResult *> records(numRuns);
+    for (int i = 0; i < numRuns; ++i)
+        records[i] = store.find(runKeys[i]);
+
+    saveSummaryResults(outputDir, records, shardTag(manifestFilter));
+    if (replications > 1)
+        saveReplicationSummary(outputDir, records, replications, shardTag(manifestFilter));
 
     cout << "\n============================================================" << endl;
     cout << "PROCESSAMENTO CONCLUIDO" << endl;
     cout << "============================================================" << endl;
-    cout << "Total de instancias processadas: " << results.size() << endl;
+    cout << "Total de instancias processadas: " << count(solved.begin(), solved.end(), 1) << endl;
+    if ((int) pendingRuns.size() < numRuns)
+        cout << "Reaproveitadas do armazem:       " << numRuns - (int) pendingRuns.size() << endl;
     cout << "Arquivos gerados em: " << outputDir << endl;
     cout << "  - summary_GA_<timestamp>.csv: Resumo geral (EXPANDIDO)" << endl;
     cout << "  - generations_<instance>.csv: Historico por geracao" << endl;
+    if (replications > 1)
+        cout << "  - replications_GA_<timestamp>.csv: Estatisticas entre as replicacoes" << endl;
+    if (gaParams.crossoverType == CrossoverType::ADAPTIVE || gaParams.mutationType == MutationType::ADAPTIVE)
+        cout << "  - operators_<instance>.csv: Uso e credito dos operadores adaptativos" << endl;
     cout << "============================================================\n"
          << endl;
 
@@ -0,0 +1,69 @@
+#include "portfolio.h"
+#include "shared_incumbent.h"
+#include "task_runtime.h"
+#include <thread>
+#include <algorithm>
+
+static const int GA_MEMBER = 0;
+static const int PSO_MEMBER = 1;
+
+PortfolioResult runPortfolio(const GAParameters &gaParams, const PortfolioPSOSettings &psoSettings,
+                             const ProblemData &problem, const string &instancePath, int defaultDueDate,
+                             const vector<int> &seedChromosome, const RandomStream &stream) {
+    PortfolioResult result;
+    int totalThreads = max(1, gaParams.numThreads);
+
+    // Meia-vida dos créditos: um décimo do tempo da execução, entre 0,5 s e 30 s
+    double halfLife = min(30.0, max(0.5, gaParams.maxCPUTimeSeconds / 10.0));
+    SharedIncumbent incumbent(2, totalThreads, halfLife);
+
+    RandomStream psoStream = stream;
+    psoStream.jump();
+
+    // O PSO roda numa thread dedicada e imprime no mesmo console da instância
+    atomic<bool> stop(false);
+    ostream &out = console();
+    thread psoThread([&] {
+        ConsoleScope scope(out);
+        resetThreadAffinity();
+        runPortfolioPSO(instancePath, defaultDueDate, psoSettings, gaParams.maxCPUTimeSeconds, gaParams.maxGenerations,
+                        totalThreads, incumbent.threadLimit(PSO_MEMBER), psoStream,
+                        incumbent.port(PSO_MEMBER), stop);
+        incumbent.retire(PSO_MEMBER);
+    });
+
+    // Sem checkpoint: a metade PSO não teria como retomar
+    GAParameters params = gaParams;
+    params.checkpointFile.clear();
+    withGeneType(problem.numJobs, [&](auto gene) {
+        GeneticAlgorithm<decltype(gene)> ga(params, problem);
+        ga.setRandomStream(stream);
+        ga.setElitePort(&incumbent.port(GA_MEMBER), 1);
+        ga.setThreadLimit(incumbent.threadLimit(GA_MEMBER));
+        result.best = ga.runWithSeed(seedChromosome);
+        result.history = ga.getHistory();
+    });
+
+    result.gaThreads = incumbent.threadsOf(GA_MEMBER);
+    result.psoThreads = incumbent.threadsOf(PSO_MEMBER);
+    incumbent.retire(GA_MEMBER);
+    stop.store(true);
+    psoThread.join();
+
+    // O PSO pode ter melhorado depois da última troca do GA; reavaliado com o objetivo do GA antes
+    // de substituir o melhor
+    vector<int> best;
+    double bestFitness;
+    if (incumbent.best(best, bestFitness)) {
+        ProblemData dataCopy = problem;
+        bestFitness = decodeChromosome(best, dataCopy);
+    }
+    if (!best.empty() && bestFitness < result.best.fitness) {
+        for (int &job: best) job -= 1;
+        result.best.chromosome = best;
+        result.best.fitness = bestFitness;
+    }
+    result.gaImprovements = incumbent.improvements(GA_MEMBER);
+    result.psoImprovements = incumbent.improvements(PSO_MEMBER);
+    return result;
+}
@@ -0,0 +1,32 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include "AlgoritmoGenetico/genetic_algorithm.h"
+#include "portfolio_pso.h"
+
+using namespace std;
+
+// ===== PORTFÓLIO GA + PSO =====
+// O GA e o PSO resolvem a mesma instância ao mesmo tempo, ligados por um SharedIncumbent: a cada
+// geração cada um publica o seu melhor e recebe o do outro quando ele é melhor (no GA entra no
+// lugar do pior indivíduo, no PSO no lugar da pior partícula e vira o globalBest). As threads de
+// --threads são divididas entre os dois conforme quem melhorou o incumbente recentemente.
+
+struct PortfolioResult
+{
+    Individual best;                 // Melhor dos dois, cromossomo 0-based
+    vector<GenerationStats> history; // Gerações do GA, que já incluem os incumbentes do PSO
+    int gaImprovements;              // Vezes que cada solver melhorou o incumbente
+    int psoImprovements;
+    int gaThreads; // Divisão das threads quando o GA terminou
+    int psoThreads;
+};
+
+// Roda os dois com o tempo e as gerações de gaParams; seedChromosome é 0-based e instancePath é
+// lido de novo pelo PSO com o mesmo defaultDueDate de problem. O PSO usa um fluxo independente
+// saltado de stream.
+PortfolioResult runPortfolio(const GAParameters &gaParams, const PortfolioPSOSettings &psoSettings,
+                             const ProblemData &problem, const string &instancePath, int defaultDueDate,
+                             const vector<int> &seedChromosome, const RandomStream &stream);
+
+#endif // PORTFOLIO_H
@@ -0,0 +1,34 @@
+#include "portfolio_pso.h"
+#include "AlgoritmoPSO/scheduling_pso.h"
+#include <climits>
+#include <limits>
+
+double runPortfolioPSO(const string &instancePath, int defaultDueDate, const PortfolioPSOSettings &settings,
+                       double maxSeconds, int maxGenerations, int numThreads, const atomic<int> *threadLimit,
+                       const RandomStream &stream, ElitePort &port, const atomic<bool> &stop) {
+    PSO pso(settings.populationSize, maxGenerations > 0 ? maxGenerations : INT_MAX, settings.c1, settings.c2,
+            settings.inertia, settings.mutationProb, settings.crossoverType, settings.mutationOperator);
+    pso.setVerbose(false);
+    pso.setRandomStream(stream);
+    pso.setTimeLimit(maxSeconds);
+    if (numThreads > 1) {
+        pso.setNeighborhood(NeighborhoodTopology::RING);
+        pso.setNumThreads(numThreads);
+        pso.setThreadLimit(threadLimit);
+    }
+    if (!pso.loadInstance(instancePath, defaultDueDate)) return numeric_limits<double>::max();
+    pso.initialize();
+
+    vector<int> incumbent;
+    double incumbentFitness;
+    for (int gen = 0; gen < pso.getNumGenerations() && !stop.load(memory_order_relaxed); gen++) {
+        pso.iterate(gen);
+
+        const Particle &best = pso.getGlobalBest();
+        port.publish(best.bestPosition, best.bestFitness);
+        if (port.receive(incumbent, incumbentFitness)) pso.acceptRemoteMigrant(incumbent);
+
+        if (pso.timeUp()) break;
+    }
+    return pso.getGlobalBest().bestFitness;
+}
@@ -0,0 +1,40 @@
+#ifndef PORTFOLIO_PSO_H
+#define PORTFOLIO_PSO_H
+
+#include "elite_port.h"
+#include "random_stream.h"
+#include <string>
+#include <atomic>
+
+using namespace std;
+
+// Lado PSO do portfólio. Fica numa unidade de tradução própria porque o modelo do PSO
+// (ModeloProblema.h) e o do GA (scheduling_ga.h) definem as mesmas estruturas e não podem ser
+// incluídos juntos; esta interface só usa tipos comuns.
+
+// Parâmetros do PSO discreto; padrões iguais aos do driver do PSO
+struct PortfolioPSOSettings
+{
+    int populationSize;
+    double c1;
+    double c2;
+    double inertia;
+    double mutationProb;
+    int crossoverType;    // 4 = PTL
+    int mutationOperator; // 4 = MultiInsert
+
+    PortfolioPSOSettings()
+        : populationSize(100), c1(0.2), c2(0.2), inertia(0.5), mutationProb(0.9), crossoverType(4),
+          mutationOperator(4) {}
+};
+
+// Roda o PSO em instancePath, lida com o mesmo defaultDueDate do GA para que os dois otimizem o
+// mesmo objetivo, até maxSeconds, maxGenerations (0 = sem limite) ou stop. A cada
+// geração publica o globalBest em port e, se chegou um incumbente do outro solver, o injeta no
+// enxame (ele passa a ser o globalBest se for melhor). Com numThreads > 1 usa a vizinhança em
+// anel, a única que paraleliza, limitada por threadLimit. Devolve o melhor fitness do enxame.
+double runPortfolioPSO(const string &instancePath, int defaultDueDate, const PortfolioPSOSettings &settings,
+                       double maxSeconds, int maxGenerations, int numThreads, const atomic<int> *threadLimit,
+                       const RandomStream &stream, ElitePort &port, const atomic<bool> &stop);
+
+#endif // PORTFOLIO_PSO_H
@@ -0,0 +1,193 @@
+#include "island_pso.h"
+#include "task_runtime.h"
+#include <thread>
+#include <iomanip>
+
+// ===== CAIXA DE CORREIO =====
+
+MigrationMailbox::MigrationMailbox(int numJobs) : middle(1), back(0), front(2) {
+    // Pré-alocar os buffers para que publish/receive não aloquem memória
+    for (Slot& slot : slots) {
+        slot.position.reserve(numJobs);
+        slot.fitness = numeric_limits<double>::max();
+    }
+}
+
+void MigrationMailbox::publish(const vector<int>& position, double fitness) {
+    slots[back].position.assign(position.begin(), position.end());
+    slots[back].fitness = fitness;
+
+    // Troca o buffer escrito pelo do meio, marcando-o como novo
+    int previous = middle.exchange(back | FRESH, memory_order_acq_rel);
+    back = previous & ~FRESH;
+}
+
+bool MigrationMailbox::receive(vector<int>& position, double& fitness) {
+    if ((middle.load(memory_order_acquire) & FRESH) == 0) {
+        return false;
+    }
+
+    int previous = middle.exchange(front, memory_order_acq_rel);
+    front = previous & ~FRESH;
+
+    position.assign(slots[front].position.begin(), slots[front].position.end());
+    fitness = slots[front].fitness;
+    return true;
+}
+
+// ===== MODELO DE ILHAS =====
+
+IslandPSO::IslandPSO(int numIslands, int migrationInterval, MigrationTopology topology,
+                     int popSize, int numGen, double c1_val, double c2_val, double inertia,
+                     double mutProb, int crossType, int mutType)
+    : numIslands(max(1, numIslands)), migrationInterval(max(1, migrationInterval)),
+      topology(topology), remoteLink(nullptr) {
+    // A população total é dividida entre as ilhas (mesmo número de avaliações do enxame único)
+    int islandPopSize = max(2, popSize / this->numIslands);
+
+    for (int i = 0; i < this->numIslands; i++) {
+        islands.push_back(make_unique<PSO>(islandPopSize, numGen, c1_val, c2_val, inertia,
+                                           mutProb, crossType, mutType));
+        islands.back()->setVerbose(false);
+    }
+}
+
+void IslandPSO::buildTopology(int numJobs) {
+    mailboxes.clear();
+    inboxes.assign(numIslands, {});
+    outboxes.assign(numIslands, {});
+
+    auto connect = [&](int from, int to) {
+        mailboxes.push_back(make_unique<MigrationMailbox>(numJobs));
+        outboxes[from].push_back(mailboxes.back().get());
+        inboxes[to].push_back(mailboxes.back().get());
+    };
+
+    if (numIslands < 2) return;
+
+    for (int i = 0; i < numIslands; i++) {
+        if (topology == MigrationTopology::RING) {
+            connect(i, (i + 1) % numIslands);
+        } else {
+            for (int j = 0; j < numIslands; j++) {
+                if (j != i) connect(i, j);
+            }
+        }
+    }
+}
+
+void IslandPSO::runIsland(int island) {
+    resetThreadAffinity();
+    PSO& pso = *islands[island];
+    pso.initialize();
+
+    vector<int> migrant;
+    double migrantFitness;
+
+    for (int gen = 0; gen < pso.getNumGenerations(); gen++) {
+        pso.iterate(gen);
+        if (pso.timeUp()) break;
+
+        if ((gen + 1) % migrationInterval != 0) continue;
+
+        // Migração assíncrona: publica o elite e absorve o que já chegou, sem esperar ninguém
+        const Particle& elite = pso.getGlobalBest();
+        for (MigrationMailbox* outbox : outboxes[island]) {
+            outbox->publish(elite.bestPosition, elite.bestFitness);
+        }
+        for (MigrationMailbox* inbox : inboxes[island]) {
+            if (inbox->receive(migrant, migrantFitness)) {
+                pso.acceptMigrant(migrant, migrantFitness);
+            }
+        }
+
+        // Processos vizinhos: mesmo protocolo de elites, pela rede e sem esperar
+        if (island == 0 && remoteLink) {
+            remoteLink->publish(elite.bestPosition, elite.bestFitness);
+            while (remoteLink->receive(migrant, migrantFitness)) {
+                pso.acceptRemoteMigrant(migrant);
+            }
+        }
+    }
+}
+
+void IslandPSO::mergeHistories() {
+    generationHistory.clear();
+
+    size_t numGen = islands[0]->getHistory().size();
+    for (const auto& pso : islands) {
+        numGen = min(numGen, pso->getHistory().size());
+    }
+
+    for (size_t g = 0; g < numGen; g++) {
+        GenerationStats stats;
+        stats.generation = (int) g;
+        stats.bestFitness = numeric_limits<double>::max();
+        stats.avgFitness = 0.0;
+        stats.worstFitness = 0.0;
+        stats.elapsedTime = 0.0;
+
+        for (const auto& pso : islands) {
+            const GenerationStats& s = pso->getHistory()[g];
+            stats.bestFitness = min(stats.bestFitness, s.bestFitness);
+            stats.avgFitness += s.avgFitness;
+            stats.worstFitness = max(stats.worstFitness, s.worstFitness);
+            stats.elapsedTime = max(stats.elapsedTime, s.elapsedTime);
+        }
+        stats.avgFitness /= numIslands;
+
+        generationHistory.push_back(stats);
+    }
+}
+
+void IslandPSO::run(const string& instanceFile, const string& outputFile) {
+    for (auto& pso : islands) {
+        if (!pso->loadInstance(instanceFile)) {
+            return;
+        }
+    }
+
+    int numJobs = 0;
+    ifstream instFile(instanceFile);
+    instFile >> numJobs;
+    buildTopology(numJobs);
+
+    console() << "Executando PSO em " << numIslands << " ilhas (migracao a cada "
+         << migrationInterval << " geracoes, topologia "
+         << migrationTopologyToString(topology) << (remoteLink ? ", com processos vizinhos" : "") << ")..." << endl;
+
+    vector<thread> threads;
+    for (int i = 0; i < numIslands; i++) {
+        threads.emplace_back(&IslandPSO::runIsland, this, i);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Melhor global entre as ilhas
+    globalBest = Particle();
+    for (const auto& pso : islands) {
+        const Particle& best = pso->getGlobalBest();
+        if (best.bestFitness < globalBest.bestFitness) {
+            globalBest = best;
+        }
+    }
+
+    mergeHistories();
+    saveGenerationHistory(generationHistory, outputFile);
+
+    console() << fixed << setprecision(2);
+    for (int i = 0; i < numIslands; i++) {
+        console() << "  Ilha " << i << ": Best=" << islands[i]->getGlobalBest().bestFitness << endl;
+    }
+    console() << "\nResultados salvos em: " << outputFile << endl;
+    console() << "Melhor solução encontrada: " << globalBest.bestFitness << endl;
+}
+
+string migrationTopologyToString(MigrationTopology topology) {
+    switch (topology) {
+        case MigrationTopology::RING: return "ring";
+        case MigrationTopology::FULL: return "full";
+        default: return "unknown";
+    }
+}
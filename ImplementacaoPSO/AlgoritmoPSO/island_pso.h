@@ -0,0 +1,118 @@
+#ifndef ISLAND_PSO_H
+#define ISLAND_PSO_H
+
+#include "scheduling_pso.h"
+#include "migration_link.h"
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+// ===== MODELO DE ILHAS =====
+
+// Topologia de migração entre as ilhas
+enum class MigrationTopology {
+    RING,  // Ilha i envia para a ilha (i + 1) % N
+    FULL   // Cada ilha envia para todas as outras
+};
+
+// Caixa de correio lock-free de produtor único e consumidor único (triple buffering).
+// O produtor publica sempre sem bloquear e o consumidor lê apenas o elite mais recente;
+// elites antigos não lidos são simplesmente sobrescritos.
+class MigrationMailbox {
+public:
+    explicit MigrationMailbox(int numJobs);
+
+    // Chamado apenas pela ilha de origem
+    void publish(const vector<int> &position, double fitness);
+
+    // Chamado apenas pela ilha de destino; retorna false se não há elite novo
+    bool receive(vector<int> &position, double &fitness);
+
+private:
+    static constexpr int FRESH = 4; // Bit que marca o buffer do meio como não lido
+
+    struct Slot {
+        vector<int> position;
+        double fitness;
+    };
+
+    Slot slots[3];
+    alignas(64) atomic<int> middle; // Índice do buffer compartilhado | FRESH
+    alignas(64) int back;           // Buffer de escrita (produtor)
+    alignas(64) int front;          // Buffer de leitura (consumidor)
+};
+
+// Vários sub-enxames PSO, cada um em sua thread com RNG e dados do problema próprios,
+// trocando periodicamente o globalBest pelas caixas de correio.
+class IslandPSO {
+private:
+    int numIslands;
+    int migrationInterval; // Gerações entre migrações
+    MigrationTopology topology;
+
+    vector<unique_ptr<PSO>> islands;
+    vector<unique_ptr<MigrationMailbox>> mailboxes;
+    vector<vector<MigrationMailbox *>> inboxes;  // inboxes[i]: caixas lidas pela ilha i
+    vector<vector<MigrationMailbox *>> outboxes; // outboxes[i]: caixas escritas pela ilha i
+
+    MigrationLink *remoteLink; // Ilhas em outros processos (nullptr = só as locais)
+
+    Particle globalBest;
+    vector<GenerationStats> generationHistory;
+
+    void buildTopology(int numJobs);
+
+    void runIsland(int island);
+
+    void mergeHistories();
+
+public:
+    IslandPSO(int numIslands, int migrationInterval, MigrationTopology topology,
+              int popSize, int numGen, double c1_val, double c2_val, double inertia,
+              double mutProb, int crossType, int mutType);
+
+    // Executar o algoritmo
+    void run(const string &instanceFile, const string &outputFile);
+
+    // Vizinhança usada dentro de cada ilha
+    void setNeighborhood(NeighborhoodTopology topology) {
+        for (auto &pso : islands) pso->setNeighborhood(topology);
+    }
+
+    // Liga a ilha 0 às ilhas de outros processos: a cada migração ela também publica o seu elite
+    // no link e absorve os que chegaram por ele. O link deve estar em beginRun() desta execução
+    void setMigrationLink(MigrationLink *link) { remoteLink = link; }
+
+    // Limite de tempo de cada ilha (todas começam juntas)
+    void setTimeLimit(double seconds) {
+        for (auto &pso : islands) pso->setTimeLimit(seconds);
+    }
+
+    // Cada ilha recebe o fluxo avançado por jump(), sem sobreposição entre ilhas. A migração é
+    // assíncrona, então a semente fixa a inicialização mas não o resultado final
+    void setRandomStream(RandomStream stream) {
+        for (auto &pso : islands) {
+            stream.jump();
+            pso->setRandomStream(stream);
+        }
+    }
+
+    // Getters
+    const Particle &getGlobalBest() const { return globalBest; }
+    const vector<GenerationStats> &getHistory() const { return generationHistory; }
+
+    string getGlobalBestPositionString() const {
+        ostringstream oss;
+        const auto &pos = globalBest.bestPosition;
+        for (size_t i = 0; i < pos.size(); i++) {
+            if (i > 0) oss << "-";
+            oss << pos[i];
+        }
+        return oss.str();
+    }
+};
+
+string migrationTopologyToString(MigrationTopology topology);
+
+#endif // ISLAND_PSO_H
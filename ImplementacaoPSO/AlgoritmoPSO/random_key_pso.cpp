@@ -0,0 +1,248 @@
+#include "random_key_pso.h"
+#include <fstream>
+#include <iomanip>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// ===== GERADOR DAS CHAVES =====
+
+void KeyRandom::seed(uint64_t seedValue) {
+    // SplitMix64 para espalhar a semente entre as trilhas (xorshift32 não aceita estado zero)
+    for (uint32_t &lane: lanes) {
+        seedValue += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = seedValue;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        lane = (uint32_t) z | 1u;
+    }
+}
+
+void KeyRandom::next8(float *out) {
+    for (int k = 0; k < 8; k++) {
+        uint32_t x = lanes[k];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        lanes[k] = x;
+        out[k] = (float) (x >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+// ===== KERNEL DE VELOCIDADE =====
+
+// Atualiza velocidade e posição de uma partícula inteira (stride múltiplo de 8).
+// É aritmética pura sobre arrays contíguos; com AVX2 processa 8 chaves por instrução.
+static void updateVelocityAndPosition(float *x, float *v, const float *pbest, const float *gbest,
+                                      int stride, float w, float c1, float c2, float vmax,
+                                      KeyRandom &random) {
+#if defined(__AVX2__)
+    const __m256 vw = _mm256_set1_ps(w);
+    const __m256 vc1 = _mm256_set1_ps(c1);
+    const __m256 vc2 = _mm256_set1_ps(c2);
+    const __m256 vMax = _mm256_set1_ps(vmax);
+    const __m256 vMin = _mm256_set1_ps(-vmax);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(1.0f / 16777216.0f);
+
+    __m256i state = _mm256_load_si256((const __m256i *) random.lanes);
+
+    auto nextUniform = [&]() {
+        state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 13));
+        state = _mm256_xor_si256(state, _mm256_srli_epi32(state, 17));
+        state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 5));
+        return _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(state, 8)), scale);
+    };
+
+    for (int d = 0; d < stride; d += 8) {
+        __m256 xi = _mm256_loadu_ps(x + d);
+        __m256 vi = _mm256_loadu_ps(v + d);
+        __m256 r1 = nextUniform();
+        __m256 r2 = nextUniform();
+
+        __m256 cognitive = _mm256_mul_ps(_mm256_mul_ps(vc1, r1), _mm256_sub_ps(_mm256_loadu_ps(pbest + d), xi));
+        __m256 social = _mm256_mul_ps(_mm256_mul_ps(vc2, r2), _mm256_sub_ps(_mm256_loadu_ps(gbest + d), xi));
+        vi = _mm256_add_ps(_mm256_mul_ps(vw, vi), _mm256_add_ps(cognitive, social));
+        vi = _mm256_min_ps(vMax, _mm256_max_ps(vMin, vi));
+
+        xi = _mm256_add_ps(xi, vi);
+        xi = _mm256_min_ps(one, _mm256_max_ps(zero, xi));
+
+        _mm256_storeu_ps(v + d, vi);
+        _mm256_storeu_ps(x + d, xi);
+    }
+
+    _mm256_store_si256((__m256i *) random.lanes, state);
+#else
+    float r1[8], r2[8];
+    for (int d = 0; d < stride; d += 8) {
+        random.next8(r1);
+        random.next8(r2);
+        for (int k = 0; k < 8; k++) {
+            float xi = x[d + k];
+            float vi = w * v[d + k] + c1 * r1[k] * (pbest[d + k] - xi) + c2 * r2[k] * (gbest[d + k] - xi);
+            vi = min(vmax, max(-vmax, vi));
+            v[d + k] = vi;
+            x[d + k] = min(1.0f, max(0.0f, xi + vi));
+        }
+    }
+#endif
+}
+
+// ===== RANDOM-KEY PSO =====
+
+RandomKeyPSO::RandomKeyPSO(int popSize, int numGen, double inertia, double c1_val, double c2_val)
+    : populationSize(popSize), numGenerations(numGen), maxSeconds(0.0), inertiaWeight((float) inertia),
+      c1((float) c1_val), c2((float) c2_val), maxVelocity(0.25f), numThreads(1), verbose(true),
+      numJobs(0), stride(0) {
+    rng.seed(randomSeed());
+}
+
+double RandomKeyPSO::decodeKeys(const float *keys, DecodeWorker &worker) {
+    // Ordenar os jobs pela chave: a posição no ranking vira a prioridade em decodeChromosome
+    vector<int> &order = worker.order;
+    order.resize(numJobs);
+    for (int j = 0; j < numJobs; j++) {
+        order[j] = j + 1;
+    }
+    sort(order.begin(), order.end(), [keys](int a, int b) {
+        return keys[a - 1] < keys[b - 1] || (keys[a - 1] == keys[b - 1] && a < b);
+    });
+
+    resetProblemData(worker.problemData);
+    return decodeChromosome(order, worker.problemData);
+}
+
+void RandomKeyPSO::initializeSwarm() {
+    numJobs = problemData.numJobs;
+    stride = (numJobs + 7) / 8 * 8;
+
+    positions.assign((size_t) populationSize * stride, 0.0f);
+    velocities.assign((size_t) populationSize * stride, 0.0f);
+    bestPositions.assign((size_t) populationSize * stride, 0.0f);
+    globalBestKeys.assign(stride, 0.0f);
+    fitness.assign(populationSize, numeric_limits<double>::max());
+    bestFitness.assign(populationSize, numeric_limits<double>::max());
+    particleRandom.resize(populationSize);
+
+    uint64_t particleKey = rng();
+    float buffer[8];
+    for (int p = 0; p < populationSize; p++) {
+        particleRandom[p].seed(RandomStream(particleKey, p)());
+
+        float *x = &positions[(size_t) p * stride];
+        float *v = &velocities[(size_t) p * stride];
+        for (int d = 0; d < stride; d += 8) {
+            particleRandom[p].next8(x + d);
+            particleRandom[p].next8(buffer);
+            for (int k = 0; k < 8; k++) {
+                v[d + k] = (2.0f * buffer[k] - 1.0f) * maxVelocity;
+            }
+        }
+    }
+
+    workers.clear();
+    workers.resize(numThreads);
+    for (DecodeWorker &worker: workers) {
+        worker.problemData = problemData;
+    }
+    threadPool.reset(numThreads > 1 ? new ThreadPool(numThreads) : nullptr);
+}
+
+void RandomKeyPSO::updateParticle(int p) {
+    float *x = &positions[(size_t) p * stride];
+    updateVelocityAndPosition(x, &velocities[(size_t) p * stride], &bestPositions[(size_t) p * stride],
+                              globalBestKeys.data(), stride, inertiaWeight, c1, c2, maxVelocity,
+                              particleRandom[p]);
+}
+
+void RandomKeyPSO::run(const string &instanceFile, const string &outputFile) {
+    if (!readInstanceFromFile(instanceFile, problemData)) {
+        cerr << "Erro ao ler instância" << endl;
+        return;
+    }
+
+    globalBest = Particle();
+    generationHistory.clear();
+
+    if (verbose) console() << "Inicializando enxame (chaves aleatorias)..." << endl;
+    initializeSwarm();
+
+    startTime = chrono::high_resolution_clock::now();
+
+    if (verbose) {
+        console() << "Executando PSO (random-key, w=" << inertiaWeight << " c1=" << c1 << " c2=" << c2
+#if defined(__AVX2__)
+             << ", AVX2"
+#endif
+             << ")..." << endl;
+    }
+    console() << fixed << setprecision(2);
+
+    // Geração -1 avalia as posições iniciais; as demais movem e avaliam (PSO síncrono)
+    for (int gen = -1; gen < numGenerations; gen++) {
+        auto body = [&](int p, int w) {
+            if (gen >= 0) updateParticle(p);
+            fitness[p] = decodeKeys(&positions[(size_t) p * stride], workers[w]);
+        };
+        if (threadPool) {
+            threadPool->parallelFor(populationSize, body);
+        } else {
+            for (int p = 0; p < populationSize; p++) body(p, 0);
+        }
+
+        // Melhores pessoais e global (gbest só muda entre gerações)
+        int bestParticle = -1;
+        double sumFitness = 0.0;
+        double worstFitness = 0.0;
+        for (int p = 0; p < populationSize; p++) {
+            if (fitness[p] < bestFitness[p]) {
+                bestFitness[p] = fitness[p];
+                copy_n(&positions[(size_t) p * stride], stride, &bestPositions[(size_t) p * stride]);
+            }
+            if (fitness[p] < globalBest.bestFitness) {
+                globalBest.bestFitness = fitness[p];
+                bestParticle = p;
+            }
+            sumFitness += fitness[p];
+            worstFitness = max(worstFitness, fitness[p]);
+        }
+
+        if (bestParticle >= 0) {
+            copy_n(&positions[(size_t) bestParticle * stride], stride, globalBestKeys.begin());
+            decodeKeys(globalBestKeys.data(), workers[0]);
+            globalBest.bestPosition = workers[0].order;
+        }
+
+        if (gen < 0) continue;
+
+        double elapsedTime = chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count();
+        double avgFitness = sumFitness / populationSize;
+
+        GenerationStats stats;
+        stats.generation = gen;
+        stats.bestFitness = globalBest.bestFitness;
+        stats.avgFitness = avgFitness;
+        stats.worstFitness = worstFitness;
+        stats.elapsedTime = elapsedTime;
+        generationHistory.push_back(stats);
+
+        if (verbose && (gen % 10 == 0 || gen == numGenerations - 1)) {
+            console() << "Gen " << gen << ": Best=" << globalBest.bestFitness
+                 << " Avg=" << avgFitness << " Worst=" << worstFitness
+                 << " Time=" << elapsedTime << "s" << endl;
+        }
+        if (maxSeconds > 0.0 && elapsedTime >= maxSeconds) {
+            console() << "Tempo maximo atingido na geracao " << gen << endl;
+            break;
+        }
+    }
+
+    saveGenerationHistory(generationHistory, outputFile);
+
+    console() << "\nResultados salvos em: " << outputFile << endl;
+    console() << "Melhor solução encontrada: " << globalBest.bestFitness << endl;
+}
@@ -0,0 +1,97 @@
+#ifndef RANDOM_KEY_PSO_H
+#define RANDOM_KEY_PSO_H
+
+#include "scheduling_pso.h"
+#include <cstdint>
+
+using namespace std;
+
+// ===== PSO CONTÍNUO COM CHAVES ALEATÓRIAS =====
+
+// Gerador xorshift32 com 8 trilhas independentes, uma por posição de um vetor AVX2.
+// Produz os r1/r2 da atualização de velocidade com a mesma sequência no caminho SIMD e escalar.
+struct KeyRandom {
+    alignas(32) uint32_t lanes[8];
+
+    void seed(uint64_t seedValue);
+
+    // Próximos 8 valores uniformes em [0, 1)
+    void next8(float *out);
+};
+
+// Cada partícula é um vetor de prioridades reais (chaves). A velocidade segue a regra clássica
+// v = w*v + c1*r1*(pbest - x) + c2*r2*(gbest - x), e a decodificação ordena as chaves para
+// obter a sequência de prioridades usada por decodeChromosome.
+class RandomKeyPSO {
+private:
+    // Parâmetros
+    int populationSize;
+    int numGenerations;
+    double maxSeconds; // Limite de tempo da execução (<= 0: só as gerações)
+    float inertiaWeight;
+    float c1;
+    float c2;
+    float maxVelocity; // Limite de |v| por dimensão (chaves em [0, 1])
+    int numThreads;
+    bool verbose;
+
+    // Dados
+    ProblemData problemData;
+    int numJobs;
+    int stride; // numJobs arredondado para múltiplo de 8 (largura AVX2)
+
+    // Enxame em arrays contíguos: partícula p ocupa [p * stride, (p + 1) * stride)
+    vector<float> positions;
+    vector<float> velocities;
+    vector<float> bestPositions;
+    vector<float> globalBestKeys;
+    vector<double> fitness;
+    vector<double> bestFitness;
+    vector<KeyRandom> particleRandom; // RNG por partícula: resultado independe do número de threads
+    RandomStream rng;                 // Fluxo principal (--seed): chave das sementes das partículas
+
+    Particle globalBest; // bestPosition guarda a permutação decodificada
+    vector<GenerationStats> generationHistory;
+    chrono::high_resolution_clock::time_point startTime;
+
+    // Contexto de decodificação por thread
+    struct DecodeWorker {
+        ProblemData problemData;
+        vector<int> order;
+    };
+    vector<DecodeWorker> workers;
+    unique_ptr<ThreadPool> threadPool;
+
+    void initializeSwarm();
+
+    double decodeKeys(const float *keys, DecodeWorker &worker);
+
+    void updateParticle(int p);
+
+public:
+    RandomKeyPSO(int popSize, int numGen, double inertia, double c1_val, double c2_val);
+
+    // Executar o algoritmo
+    void run(const string &instanceFile, const string &outputFile);
+
+    void setNumThreads(int threads) { numThreads = max(1, threads); }
+    void setRandomStream(const RandomStream &stream) { rng = stream; }
+    void setTimeLimit(double seconds) { maxSeconds = seconds; }
+    void setVerbose(bool val) { verbose = val; }
+
+    // Getters
+    const Particle &getGlobalBest() const { return globalBest; }
+    const vector<GenerationStats> &getHistory() const { return generationHistory; }
+
+    string getGlobalBestPositionString() const {
+        ostringstream oss;
+        const auto &pos = globalBest.bestPosition;
+        for (size_t i = 0; i < pos.size(); i++) {
+            if (i > 0) oss << "-";
+            oss << pos[i];
+        }
+        return oss.str();
+    }
+};
+
+#endif // RANDOM_KEY_PSO_H
@@ -4,36 +4,23 @@
 
 PSO::PSO(int popSize, int numGen, double c1_val, double c2_val, double inertia,
          double mutProb, int crossType, int mutType)
-    : populationSize(popSize), numGenerations(numGen), c1(c1_val), c2(c2_val),
+    : populationSize(popSize), numGenerations(numGen), maxSeconds(0.0), c1(c1_val), c2(c2_val),
       inertiaWeight(inertia), mutationProb(mutProb), crossoverType(crossType),
-      mutationOperator(mutType), uniformDist(0.0, 1.0) {
-    random_device rd;
-    rng.seed(rd());
+      mutationOperator(mutType), verbose(true), neighborhood(NeighborhoodTopology::GLOBAL),
+      numThreads(1), threadLimit(nullptr), crossoverBandit({"OC", "PMX", "PTL"}),
+      mutationBandit({"Swap", "Insert", "MultiSwap", "MultiInsert"}), checkpointInterval(0.0), resume(false),
+      lastCheckpointTime(0.0), firstGeneration(0), resumedTime(0.0), iterateFn(nullptr) {
+    rng.seed(randomSeed());
 }
 
 PSO::~PSO() {}
 
-void PSO::resetProblemData() {
-    // Limpar máquinas
-    for (auto& machine : problemData.machines) {
-        machine.second.buffer.clear();
-        machine.second.availableTime = 0.0;
-        machine.second.isBusy = 0;
-        machine.second.currentJob = nullptr;
-    }
-
-    // Limpar jobs
-    for (auto& job : problemData.jobs) {
-        job.priority = 0.0;
-        job.tardiness = 0.0;
-        fill(job.completionTimes.begin(), job.completionTimes.end(), 0.0);
-    }
-}
-
 void PSO::initializeSwarm() {
     swarm.clear();
     swarm.resize(populationSize);
 
+    SwarmWorker& worker = workers[0];
+
     // Criar uma permutação base
     vector<int> basePermutation(problemData.numJobs);
     for (int i = 0; i < problemData.numJobs; i++) {
@@ -45,18 +32,17 @@ void PSO::initializeSwarm() {
         swarm[p].bestPosition = basePermutation;
 
         // Embaralhar para criar diversidade
-        shuffle(swarm[p].position.begin(), swarm[p].position.end(), rng);
+        worker.rng.shuffle(swarm[p].position.begin(), swarm[p].position.end());
 
         // Inicializar velocidade como lista de movimentos
         swarm[p].velocity.resize(problemData.numJobs);
         for (int i = 0; i < problemData.numJobs; i++) {
             swarm[p].velocity[i] = i;
         }
-        shuffle(swarm[p].velocity.begin(), swarm[p].velocity.end(), rng);
+        worker.rng.shuffle(swarm[p].velocity.begin(), swarm[p].velocity.end());
 
         // Avaliar partícula
-        resetProblemData();
-        swarm[p].fitness = evaluateParticle(swarm[p].position);
+        swarm[p].fitness = evaluateParticle(swarm[p].position, worker);
         swarm[p].bestFitness = swarm[p].fitness;
         swarm[p].bestPosition = swarm[p].position;
 
@@ -68,19 +54,18 @@ void PSO::initializeSwarm() {
     }
 }
 
-double PSO::evaluateParticle(vector<int>& position) {
-    return decodeChromosome(position, problemData);
+double PSO::evaluateParticle(vector<int>& position, SwarmWorker& worker) {
+    resetProblemData(worker.problemData);
+    return decodeChromosome(position, worker.problemData);
 }
 
 // ===== OPERADORES DE CROSSOVER =====
 
-vector<int> PSO::orderCrossover(const vector<int>& parent1, const vector<int>& parent2) {
+void PSO::orderCrossover(const vector<int>& parent1, const vector<int>& parent2, vector<int>& offspring, SwarmWorker& worker) {
     int n = parent1.size();
-    vector<int> offspring(n);
-    uniform_int_distribution<int> dist(0, n - 1);
-
-    int start = dist(rng);
-    int end = dist(rng);
+    offspring.resize(n);
+    int start = (int) worker.rng.below(n);
+    int end = (int) worker.rng.below(n);
     if (start > end) swap(start, end);
 
     // Copiar segmento de parent1
@@ -89,7 +74,7 @@ vector<int> PSO::orderCrossover(const vector<int>& parent1, const vector<int>& p
     }
 
     // Preencher com elementos de parent2
-    vector<bool> used(n + 1, false);
+    vector<char>& used = worker.markUsed(n);
     for (int i = start; i <= end; i++) {
         used[offspring[i]] = true;
     }
@@ -106,33 +91,27 @@ vector<int> PSO::orderCrossover(const vector<int>& parent1, const vector<int>& p
         pos = (pos + 1) % n;
         parentPos = (parentPos + 1) % n;
     }
-
-    return offspring;
 }
 
-vector<int> PSO::twoPointCrossover(const vector<int>& parent1, const vector<int>& parent2) {
+void PSO::twoPointCrossover(const vector<int>& parent1, const vector<int>& parent2, vector<int>& offspring, SwarmWorker& worker) {
     int n = parent1.size();
-    vector<int> offspring = parent1;
+    offspring.assign(parent1.begin(), parent1.end());
 
-    uniform_int_distribution<int> dist(0, n - 1);
-    int point1 = dist(rng);
-    int point2 = dist(rng);
+    int point1 = (int) worker.rng.below(n);
+    int point2 = (int) worker.rng.below(n);
     if (point1 > point2) swap(point1, point2);
 
     for (int i = point1; i < point2; i++) {
         offspring[i] = parent2[i];
     }
-
-    return offspring;
 }
 
-vector<int> PSO::pmxCrossover(const vector<int>& parent1, const vector<int>& parent2) {
+void PSO::pmxCrossover(const vector<int>& parent1, const vector<int>& parent2, vector<int>& offspring, SwarmWorker& worker) {
     int n = parent1.size();
-    vector<int> offspring(n);
+    offspring.resize(n);
 
-    uniform_int_distribution<int> dist(0, n - 1);
-    int point1 = dist(rng);
-    int point2 = dist(rng);
+    int point1 = (int) worker.rng.below(n);
+    int point2 = (int) worker.rng.below(n);
     if (point1 > point2) swap(point1, point2);
 
     // Copiar segmento de parent1
@@ -170,7 +149,7 @@ vector<int> PSO::pmxCrossover(const vector<int>& parent1, const vector<int>& par
     }
 
     // Preencher posições restantes
-    vector<bool> used(n + 1, false);
+    vector<char>& used = worker.markUsed(n);
     for (int i = 0; i < n; i++) {
         if (i >= point1 && i <= point2) {
             used[offspring[i]] = true;
@@ -186,26 +165,25 @@ vector<int> PSO::pmxCrossover(const vector<int>& parent1, const vector<int>& par
             idx2++;
         }
     }
-
-    return offspring;
 }
 
-vector<int> PSO::ptlCrossover(const vector<int>& parent1, const vector<int>& parent2) {
+void PSO::ptlCrossover(const vector<int>& parent1, const vector<int>& parent2, vector<int>& offspring, SwarmWorker& worker) {
     // PTL (Position-based Crossover com Three-parent Like)
     // Implementação simplificada: usar posições de parent1 com valores aleatórios de ambos
     int n = parent1.size();
-    vector<int> offspring;
-    vector<bool> used(n + 1, false);
+    offspring.resize(n);
+    vector<char>& used = worker.markUsed(n);
+    int k = 0;
 
     for (int i = 0; i < n; i++) {
-        if (uniformDist(rng) < 0.5) {
+        if (worker.uniform() < 0.5) {
             if (!used[parent1[i]]) {
-                offspring.push_back(parent1[i]);
+                offspring[k++] = parent1[i];
                 used[parent1[i]] = true;
             }
         } else {
             if (!used[parent2[i]]) {
-                offspring.push_back(parent2[i]);
+                offspring[k++] = parent2[i];
                 used[parent2[i]] = true;
             }
         }
@@ -214,31 +192,27 @@ vector<int> PSO::ptlCrossover(const vector<int>& parent1, const vector<int>& par
     // Preencher com elementos faltantes
     for (int i = 1; i <= n; i++) {
         if (!used[i]) {
-            offspring.push_back(i);
+            offspring[k++] = i;
         }
     }
-
-    return offspring;
 }
 
 // ===== OPERADORES DE MUTAÇÃO =====
 
-void PSO::swapMutation(vector<int>& solution) {
-    if (uniformDist(rng) > mutationProb) return;
+void PSO::swapMutation(vector<int>& solution, SwarmWorker& worker) {
+    if (worker.uniform() > mutationProb) return;
 
-    uniform_int_distribution<int> dist(0, solution.size() - 1);
-    int i = dist(rng);
-    int j = dist(rng);
+    int i = (int) worker.rng.below((uint32_t) solution.size());
+    int j = (int) worker.rng.below((uint32_t) solution.size());
 
     swap(solution[i], solution[j]);
 }
 
-void PSO::insertMutation(vector<int>& solution) {
-    if (uniformDist(rng) > mutationProb) return;
+void PSO::insertMutation(vector<int>& solution, SwarmWorker& worker) {
+    if (worker.uniform() > mutationProb) return;
 
-    uniform_int_distribution<int> dist(0, solution.size() - 1);
-    int i = dist(rng);
-    int j = dist(rng);
+    int i = (int) worker.rng.below((uint32_t) solution.size());
+    int j = (int) worker.rng.below((uint32_t) solution.size());
 
     if (i != j) {
         int element = solution[i];
@@ -247,23 +221,21 @@ void PSO::insertMutation(vector<int>& solution) {
     }
 }
 
-void PSO::multiSwapMutation(vector<int>& solution) {
-    if (uniformDist(rng) > mutationProb) return;
+void PSO::multiSwapMutation(vector<int>& solution, SwarmWorker& worker) {
+    if (worker.uniform() > mutationProb) return;
 
-    int numSwaps = uniformDist(rng) * 3 + 1;  // 1-3 swaps
+    int numSwaps = worker.uniform() * 3 + 1;  // 1-3 swaps
     for (int s = 0; s < numSwaps; s++) {
-        swapMutation(solution);
+        swapMutation(solution, worker);
     }
 }
 
-void PSO::multiInsertMutation(vector<int>& solution) {
-    if (uniformDist(rng) > mutationProb) return;
+void PSO::multiInsertMutation(vector<int>& solution, SwarmWorker& worker) {
+    if (worker.uniform() > mutationProb) return;
 
     int n = solution.size();
-    uniform_int_distribution<int> dist(0, n - 1);
-
-    int r1 = dist(rng);
-    int r2 = dist(rng);
+    int r1 = (int) worker.rng.below(n);
+    int r2 = (int) worker.rng.below(n);
 
     if (r1 != r2) {
         int element = solution[r1];
@@ -275,49 +247,63 @@ void PSO::multiInsertMutation(vector<int>& solution) {
 }
 
 // ===== OPERADORES DE APRENDIZADO PSO =====
+// O tipo do operador é parâmetro de template: o switch é resolvido em tempo de compilação
+// e o operador escolhido é inlinado no laço da geração (ver selectOperators).
 
-void PSO::learnFromHistoryMutation(vector<int>& position) {
+template <int Mutation>
+void PSO::learnFromHistoryMutation(vector<int>& position, SwarmWorker& worker) {
     // Aplicar mutação (learning from history)
-    switch (mutationOperator) {
-        case 1: swapMutation(position); break;
-        case 2: insertMutation(position); break;
-        case 3: multiSwapMutation(position); break;
-        case 4: multiInsertMutation(position); break;
-        default: insertMutation(position);
+    if constexpr (Mutation == ADAPTIVE_OPERATOR) {
+        // Braço sorteado em updateParticle; braço a corresponde ao operador a + 1
+        switch (worker.mutationArm) {
+            case 0: learnFromHistoryMutation<1>(position, worker); break;
+            case 2: learnFromHistoryMutation<3>(position, worker); break;
+            case 3: learnFromHistoryMutation<4>(position, worker); break;
+            default: learnFromHistoryMutation<2>(position, worker);
+        }
     }
+    else if constexpr (Mutation == 1) swapMutation(position, worker);
+    else if constexpr (Mutation == 3) multiSwapMutation(position, worker);
+    else if constexpr (Mutation == 4) multiInsertMutation(position, worker);
+    else insertMutation(position, worker);
 }
 
-void PSO::learnFromLocalBestCrossover(const vector<int>& position, const vector<int>& localBest, vector<int>& newPosition) {
-    // Aplicar crossover com local best
-    switch (crossoverType) {
-        case 1: newPosition = orderCrossover(position, localBest); break;
-        case 2: newPosition = twoPointCrossover(position, localBest); break;
-        case 3: newPosition = pmxCrossover(position, localBest); break;
-        case 4: newPosition = ptlCrossover(position, localBest); break;
-        default: newPosition = orderCrossover(position, localBest);
+template <int Crossover>
+void PSO::applyCrossover(const vector<int>& position, const vector<int>& guide, vector<int>& offspring, SwarmWorker& worker) {
+    if constexpr (Crossover == ADAPTIVE_OPERATOR) {
+        // O TP fica fora do conjunto adaptativo: ele não preserva a permutação, e o fitness
+        // de uma sequência inválida não é comparável (nem seguro para o PMX como pai)
+        switch (worker.crossoverArm) {
+            case 1: applyCrossover<3>(position, guide, offspring, worker); break;
+            case 2: applyCrossover<4>(position, guide, offspring, worker); break;
+            default: applyCrossover<1>(position, guide, offspring, worker);
+        }
     }
+    else if constexpr (Crossover == 2) twoPointCrossover(position, guide, offspring, worker);
+    else if constexpr (Crossover == 3) pmxCrossover(position, guide, offspring, worker);
+    else if constexpr (Crossover == 4) ptlCrossover(position, guide, offspring, worker);
+    else orderCrossover(position, guide, offspring, worker);
 }
 
-void PSO::learnFromGlobalBestCrossover(const vector<int>& position, const vector<int>& globalBest, vector<int>& newPosition) {
+template <int Crossover>
+void PSO::learnFromLocalBestCrossover(const vector<int>& position, const vector<int>& localBest, vector<int>& newPosition, SwarmWorker& worker) {
+    // Aplicar crossover com local best
+    applyCrossover<Crossover>(position, localBest, newPosition, worker);
+}
+
+template <int Crossover>
+void PSO::learnFromGlobalBestCrossover(const vector<int>& position, const vector<int>& globalBest, vector<int>& newPosition, SwarmWorker& worker) {
     // Aplicar crossover com global best
-    switch (crossoverType) {
-        case 1: newPosition = orderCrossover(position, globalBest); break;
-        case 2: newPosition = twoPointCrossover(position, globalBest); break;
-        case 3: newPosition = pmxCrossover(position, globalBest); break;
-        case 4: newPosition = ptlCrossover(position, globalBest); break;
-        default: newPosition = orderCrossover(position, globalBest);
-    }
+    applyCrossover<Crossover>(position, globalBest, newPosition, worker);
 }
 
 // ===== ILS - LOCAL SEARCH =====
 
-void PSO::ilsLocalSearch(vector<int>& solution) {
+void PSO::ilsLocalSearch(vector<int>& solution, SwarmWorker& worker) {
     // Fase de destruição + construção
     int n = solution.size();
-    uniform_int_distribution<int> dist(0, n - 1);
-
     // Destruição: remover um elemento
-    int r1 = dist(rng);
+    int r1 = (int) worker.rng.below(n);
     int element = solution[r1];
     solution.erase(solution.begin() + r1);
 
@@ -325,12 +311,12 @@ void PSO::ilsLocalSearch(vector<int>& solution) {
     double bestFitness = numeric_limits<double>::max();
     int bestPos = 0;
 
+    vector<int>& temp = worker.ilsBuffer;
     for (int pos = 0; pos <= (int)solution.size(); pos++) {
-        vector<int> temp = solution;
+        temp.assign(solution.begin(), solution.end());
         temp.insert(temp.begin() + pos, element);
 
-        resetProblemData();
-        double fit = evaluateParticle(temp);
+        double fit = evaluateParticle(temp, worker);
 
         if (fit < bestFitness) {
             bestFitness = fit;
@@ -343,100 +329,315 @@ void PSO::ilsLocalSearch(vector<int>& solution) {
 
 // ===== EXECUTAR ALGORITMO =====
 
-void PSO::run(const string& instanceFile, const string& outputFile) {
-    // Ler instância
-    if (!readInstanceFromFile(instanceFile, problemData)) {
+bool PSO::loadInstance(const string& instanceFile, int defaultDueDate) {
+    if (!readInstanceFromFile(instanceFile, problemData, defaultDueDate)) {
         cerr << "Erro ao ler instância" << endl;
-        return;
+        return false;
     }
+    return true;
+}
 
+void PSO::initialize() {
     // Inicializar global best
     globalBest.bestFitness = numeric_limits<double>::max();
+    generationHistory.clear();
+
+    initializeWorkers();
 
     // Inicializar enxame
-    cout << "Inicializando enxame..." << endl;
+    if (verbose) console() << "Inicializando enxame..." << endl;
     initializeSwarm();
 
-    auto startTime = chrono::high_resolution_clock::now();
+    startTime = chrono::high_resolution_clock::now();
+}
 
-    cout << "Executando PSO..." << endl;
-    cout << fixed << setprecision(2);
+void PSO::initializeWorkers() {
+    // Um contexto (RNG + dados do problema) por thread; os fluxos derivam de uma única chave
+    uint64_t workerKey = rng();
+    workers.clear();
+    workers.resize(numThreads);
+    for (size_t w = 0; w < workers.size(); w++) {
+        SwarmWorker& worker = workers[w];
+        worker.rng = RandomStream(workerKey, w);
+        worker.problemData = problemData;
+        worker.crossoverUsage.reset(crossoverBandit.size());
+        worker.mutationUsage.reset(mutationBandit.size());
+    }
+    threadPool.reset(numThreads > 1 ? new ThreadPool(numThreads) : nullptr);
+    if (threadPool) threadPool->setLimit(threadLimit);
+    selectOperators();
+}
 
-    // Loop principal
-    for (int gen = 0; gen < numGenerations; gen++) {
-        double sumFitness = 0.0;
-        double worstFitness = 0.0;
+template <int Crossover, int Mutation>
+void PSO::updateParticle(int p, const vector<int>& socialBest, int gen, SwarmWorker& worker) {
+    // Com operadores adaptativos, cada um é creditado pela redução do fitness da partícula
+    // dividida pelo seu tempo somado ao da decodificação da nova posição
+    constexpr bool adaptiveCrossover = Crossover == ADAPTIVE_OPERATOR;
+    constexpr bool adaptiveMutation = Mutation == ADAPTIVE_OPERATOR;
+    constexpr bool timed = adaptiveCrossover || adaptiveMutation;
+    auto tick = [] {
+        return timed ? chrono::steady_clock::now() : chrono::steady_clock::time_point();
+    };
+
+    if constexpr (adaptiveCrossover) worker.crossoverArm = crossoverBandit.select(worker.uniform());
+    if constexpr (adaptiveMutation) worker.mutationArm = mutationBandit.select(worker.uniform());
+
+    // Step 5.1: Learning from history
+    vector<int>& newPos = worker.candidate;
+    newPos.assign(swarm[p].position.begin(), swarm[p].position.end());
+    auto opStart = tick();
+    learnFromHistoryMutation<Mutation>(newPos, worker);
+    long long mutationNs = timed ? nanosecondsSince(opStart) : 0;
+
+    // Step 5.2: Learning from local best
+    opStart = tick();
+    bool crossed = false;
+    if (worker.uniform() < c1) {
+        learnFromLocalBestCrossover<Crossover>(newPos, swarm[p].bestPosition, worker.offspring, worker);
+        newPos.swap(worker.offspring);
+        crossed = true;
+    }
 
-        // Atualizar cada partícula
-        for (int p = 0; p < populationSize; p++) {
-            // Step 5.1: Learning from history
-            vector<int> newPos = swarm[p].position;
-            learnFromHistoryMutation(newPos);
+    // Step 5.3: Learning from global best (ou melhor da vizinhança)
+    if (worker.uniform() < c2) {
+        learnFromGlobalBestCrossover<Crossover>(newPos, socialBest, worker.offspring, worker);
+        newPos.swap(worker.offspring);
+        crossed = true;
+    }
+    long long crossoverNs = timed ? nanosecondsSince(opStart) : 0;
 
-            // Step 5.2: Learning from local best
-            if (uniformDist(rng) < c1) {
-                learnFromLocalBestCrossover(newPos, swarm[p].bestPosition, newPos);
-            }
+    // Aplicar ILS-based local search ao melhor da geração (opcional, melhora convergência)
+    bool localSearch = gen % 5 == 0;
+    if (localSearch) {  // A cada 5 gerações
+        ilsLocalSearch(newPos, worker);
+    }
 
-            // Step 5.3: Learning from global best
-            if (uniformDist(rng) < c2) {
-                learnFromGlobalBestCrossover(newPos, globalBest.bestPosition, newPos);
+    // Avaliar nova posição
+    auto decodeStart = tick();
+    double newFitness = evaluateParticle(newPos, worker);
+
+    // Gerações com ILS não creditam: a melhoria seria da busca local, não do operador
+    if constexpr (timed) {
+        long long decodeNs = nanosecondsSince(decodeStart);
+        double gain = swarm[p].fitness - newFitness;
+        if (!localSearch) {
+            if (adaptiveMutation) {
+                worker.mutationUsage.record(worker.mutationArm, gain, mutationNs + decodeNs);
             }
-
-            // Aplicar ILS-based local search ao melhor da geração (opcional, melhora convergência)
-            if (gen % 5 == 0) {  // A cada 5 gerações
-                ilsLocalSearch(newPos);
+            if (adaptiveCrossover && crossed) {
+                worker.crossoverUsage.record(worker.crossoverArm, gain, crossoverNs + decodeNs);
             }
+        }
+    }
 
-            // Avaliar nova posição
-            resetProblemData();
-            double newFitness = evaluateParticle(newPos);
+    // Atualizar melhor pessoal
+    if (newFitness < swarm[p].bestFitness) {
+        swarm[p].bestFitness = newFitness;
+        swarm[p].bestPosition = newPos;
+    }
 
-            // Atualizar melhor pessoal
-            if (newFitness < swarm[p].bestFitness) {
-                swarm[p].bestFitness = newFitness;
-                swarm[p].bestPosition = newPos;
-            }
+    // Atualizar posição
+    swarm[p].position = newPos;
+    swarm[p].fitness = newFitness;
+}
 
-            // Atualizar posição
-            swarm[p].position = newPos;
-            swarm[p].fitness = newFitness;
+void PSO::updateGlobalBest(int p) {
+    if (swarm[p].fitness < globalBest.bestFitness) {
+        globalBest.bestFitness = swarm[p].fitness;
+        globalBest.bestPosition = swarm[p].position;
+    }
+}
+
+void PSO::creditOperators(int gen) {
+    for (SwarmWorker& worker : workers) {
+        crossoverBandit.usage().merge(worker.crossoverUsage);
+        mutationBandit.usage().merge(worker.mutationUsage);
+        worker.crossoverUsage.reset(crossoverBandit.size());
+        worker.mutationUsage.reset(mutationBandit.size());
+    }
+    if (crossoverType == ADAPTIVE_OPERATOR) crossoverBandit.endGeneration(gen);
+    if (mutationOperator == ADAPTIVE_OPERATOR) mutationBandit.endGeneration(gen);
+}
+
+void PSO::snapshotNeighborhoodBest() {
+    neighborhoodBest.resize(populationSize);
 
-            // Atualizar melhor global
-            if (newFitness < globalBest.bestFitness) {
-                globalBest.bestFitness = newFitness;
-                globalBest.bestPosition = newPos;
+    // Grade toroidal aproximadamente quadrada para von Neumann
+    int cols = max(1, (int) ceil(sqrt((double) populationSize)));
+
+    for (int p = 0; p < populationSize; p++) {
+        int neighbors[5];
+        int count = 0;
+        neighbors[count++] = p;
+        neighbors[count++] = (p + populationSize - 1) % populationSize;
+        neighbors[count++] = (p + 1) % populationSize;
+        if (neighborhood == NeighborhoodTopology::VON_NEUMANN) {
+            neighbors[count++] = (p + populationSize - cols % populationSize) % populationSize;
+            neighbors[count++] = (p + cols) % populationSize;
+        }
+
+        int best = p;
+        for (int k = 1; k < count; k++) {
+            if (swarm[neighbors[k]].bestFitness < swarm[best].bestFitness) {
+                best = neighbors[k];
             }
+        }
+        neighborhoodBest[p] = swarm[best].bestPosition;
+    }
+}
+
+void PSO::iterate(int gen) {
+    (this->*iterateFn)(gen);
+}
+
+template <int Crossover, int Mutation>
+void PSO::iterateWith(int gen) {
+    // Fluxos dos workers derivados da chave da geração: nenhum estado deles passa de uma geração
+    // para a outra, então o checkpoint só precisa do fluxo principal
+    uint64_t generationKey = rng();
+    if (neighborhood == NeighborhoodTopology::GLOBAL) {
+        // gbest: cada partícula vê imediatamente as melhorias das anteriores
+        workers[0].rng = RandomStream(generationKey, 0);
+        for (int p = 0; p < populationSize; p++) {
+            updateParticle<Crossover, Mutation>(p, globalBest.bestPosition, gen, workers[0]);
+            updateGlobalBest(p);
+        }
+    } else {
+        // lbest: as partículas leem apenas o snapshot da geração anterior,
+        // então podem ser atualizadas em paralelo sem sincronização
+        snapshotNeighborhoodBest();
+
+        // Fluxo por partícula (chave da geração + índice): o resultado não depende do escalonamento
+        auto body = [&](int p, int w) {
+            workers[w].rng = RandomStream(generationKey, p);
+            updateParticle<Crossover, Mutation>(p, neighborhoodBest[p], gen, workers[w]);
+        };
+        if (threadPool) {
+            threadPool->parallelFor(populationSize, body);
+        } else {
+            for (int p = 0; p < populationSize; p++) body(p, 0);
+        }
+        workers[0].rng = RandomStream(generationKey, populationSize);
 
-            sumFitness += swarm[p].fitness;
-            worstFitness = max(worstFitness, swarm[p].fitness);
+        // O melhor global verdadeiro continua sendo acompanhado para o relatório
+        for (int p = 0; p < populationSize; p++) {
+            updateGlobalBest(p);
         }
+    }
+
+    if constexpr (Crossover == ADAPTIVE_OPERATOR || Mutation == ADAPTIVE_OPERATOR) {
+        creditOperators(gen);
+    }
 
-        auto currentTime = chrono::high_resolution_clock::now();
-        double elapsedTime = chrono::duration<double>(currentTime - startTime).count();
+    double sumFitness = 0.0;
+    double worstFitness = 0.0;
+    for (int p = 0; p < populationSize; p++) {
+        sumFitness += swarm[p].fitness;
+        worstFitness = max(worstFitness, swarm[p].fitness);
+    }
+
+    auto currentTime = chrono::high_resolution_clock::now();
+    double elapsedTime = chrono::duration<double>(currentTime - startTime).count();
 
-        double avgFitness = sumFitness / populationSize;
+    double avgFitness = sumFitness / populationSize;
 
-        // Armazenar estatísticas
-        GenerationStats stats;
-        stats.generation = gen;
-        stats.bestFitness = globalBest.bestFitness;
-        stats.avgFitness = avgFitness;
-        stats.worstFitness = worstFitness;
-        stats.elapsedTime = elapsedTime;
-        generationHistory.push_back(stats);
+    // Armazenar estatísticas
+    GenerationStats stats;
+    stats.generation = gen;
+    stats.bestFitness = globalBest.bestFitness;
+    stats.avgFitness = avgFitness;
+    stats.worstFitness = worstFitness;
+    stats.elapsedTime = elapsedTime;
+    generationHistory.push_back(stats);
+
+    if (verbose && (gen % 10 == 0 || gen == numGenerations - 1)) {
+        console() << "Gen " << gen << ": Best=" << globalBest.bestFitness
+             << " Avg=" << avgFitness << " Worst=" << worstFitness
+             << " Time=" << elapsedTime << "s" << endl;
+    }
+}
+
+template <int Crossover>
+PSO::IterateFn PSO::selectIterate(int mutation) {
+    switch (mutation) {
+        case 1: return &PSO::iterateWith<Crossover, 1>;
+        case 3: return &PSO::iterateWith<Crossover, 3>;
+        case 4: return &PSO::iterateWith<Crossover, 4>;
+        case ADAPTIVE_OPERATOR: return &PSO::iterateWith<Crossover, ADAPTIVE_OPERATOR>;
+        default: return &PSO::iterateWith<Crossover, 2>;
+    }
+}
 
-        if (gen % 10 == 0 || gen == numGenerations - 1) {
-            cout << "Gen " << gen << ": Best=" << globalBest.bestFitness
-                 << " Avg=" << avgFitness << " Worst=" << worstFitness
-                 << " Time=" << elapsedTime << "s" << endl;
+void PSO::selectOperators() {
+    // Único despacho em tempo de execução: escolhe a instância do laço para o par de operadores
+    switch (crossoverType) {
+        case 2: iterateFn = selectIterate<2>(mutationOperator); break;
+        case 3: iterateFn = selectIterate<3>(mutationOperator); break;
+        case 4: iterateFn = selectIterate<4>(mutationOperator); break;
+        case ADAPTIVE_OPERATOR: iterateFn = selectIterate<ADAPTIVE_OPERATOR>(mutationOperator); break;
+        default: iterateFn = selectIterate<1>(mutationOperator);
+    }
+}
+
+void PSO::acceptMigrant(const vector<int>& position, double fitness) {
+    // Pior partícula pelo fitness atual
+    int worstIdx = 0;
+    for (int p = 1; p < populationSize; p++) {
+        if (swarm[p].fitness > swarm[worstIdx].fitness) {
+            worstIdx = p;
         }
     }
 
+    Particle& worst = swarm[worstIdx];
+    if (fitness >= worst.fitness) return;
+
+    worst.position = position;
+    worst.fitness = fitness;
+    if (fitness < worst.bestFitness) {
+        worst.bestFitness = fitness;
+        worst.bestPosition = position;
+    }
+
+    if (fitness < globalBest.bestFitness) {
+        globalBest.bestFitness = fitness;
+        globalBest.bestPosition = position;
+    }
+}
+
+void PSO::acceptRemoteMigrant(vector<int>& position) {
+    if ((int) position.size() != problemData.numJobs) return;
+    acceptMigrant(position, evaluateParticle(position, workers[0]));
+}
+
+void PSO::saveHistory(const string& outputFile) const {
+    saveGenerationHistory(generationHistory, outputFile);
+}
+
+void PSO::saveOperatorLog(const string& outputFile) const {
+    bool adaptiveCrossover = crossoverType == ADAPTIVE_OPERATOR;
+    bool adaptiveMutation = mutationOperator == ADAPTIVE_OPERATOR;
+    if (!adaptiveCrossover && !adaptiveMutation) return;
+
+    ofstream file(outputFile);
+    OperatorBandit::writeLogHeader(file);
+    if (adaptiveCrossover) crossoverBandit.writeLog(file, "Crossover");
+    if (adaptiveMutation) mutationBandit.writeLog(file, "Mutation");
+}
+
+string neighborhoodTopologyToString(NeighborhoodTopology topology) {
+    switch (topology) {
+        case NeighborhoodTopology::GLOBAL: return "global";
+        case NeighborhoodTopology::RING: return "ring";
+        case NeighborhoodTopology::VON_NEUMANN: return "vonneumann";
+        default: return "unknown";
+    }
+}
+
+void saveGenerationHistory(const vector<GenerationStats>& history, const string& outputFile) {
     // Salvar resultados em CSV
     ofstream csvFile(outputFile);
     csvFile << "Generation,BestFitness,AvgFitness,WorstFitness,ElapsedTime" << endl;
-    for (const auto& stats : generationHistory) {
+    for (const auto& stats : history) {
         csvFile << stats.generation << ","
                 << fixed << setprecision(1) << stats.bestFitness << ","
                 << stats.avgFitness << ","
@@ -444,7 +645,150 @@ void PSO::run(const string& instanceFile, const string& outputFile) {
                 << stats.elapsedTime << endl;
     }
     csvFile.close();
+}
+
+// ===== CHECKPOINT =====
+// Enxame, melhor global, fluxo principal e histórico. Os fluxos dos workers não entram: cada
+// geração os deriva de uma chave do fluxo principal. Os bandits recomeçam do zero na retomada.
+
+void PSO::saveCheckpoint(int nextGeneration, double elapsedTime, bool wait) {
+    CheckpointBuffer& buffer = checkpointWriter->buffer();
+    buffer.begin(CheckpointKind::PSO);
+    buffer.put<int32_t>(problemData.numJobs);
+    buffer.put<int32_t>(populationSize);
+    buffer.put(elapsedTime);
+    buffer.put<int32_t>(nextGeneration);
+
+    for (const Particle& particle : swarm) {
+        buffer.putVector(particle.position);
+        buffer.putVector(particle.bestPosition);
+        buffer.putVector(particle.velocity);
+        buffer.put(particle.fitness);
+        buffer.put(particle.bestFitness);
+    }
+    buffer.putVector(globalBest.bestPosition);
+    buffer.put(globalBest.bestFitness);
+
+    buffer.putRng(rng);
+    buffer.putVector(generationHistory);
 
-    cout << "\nResultados salvos em: " << outputFile << endl;
-    cout << "Melhor solução encontrada: " << globalBest.bestFitness << endl;
-}
\ No newline at end of file
+    if (wait) {
+        checkpointWriter->submitAndWait();
+    } else {
+        checkpointWriter->submit();
+    }
+    lastCheckpointTime = elapsedTime;
+}
+
+bool PSO::loadCheckpoint() {
+    CheckpointReader reader;
+    if (!reader.open(checkpointFile, CheckpointKind::PSO)) return false;
+
+    int32_t storedJobs = 0, storedSize = 0;
+    reader.get(storedJobs);
+    reader.get(storedSize);
+    if (!reader.ok() || storedJobs != problemData.numJobs || storedSize != populationSize) {
+        console() << "AVISO: Checkpoint de outra instancia ou populacao, iniciando do zero" << endl;
+        return false;
+    }
+
+    // Tudo é lido em temporários: um arquivo truncado não deixa o enxame pela metade
+    double elapsedTime = 0.0;
+    int32_t nextGeneration = 0;
+    reader.get(elapsedTime);
+    reader.get(nextGeneration);
+
+    size_t numJobs = (size_t) storedJobs;
+    bool sizesOk = true;
+    vector<Particle> restoredSwarm(storedSize);
+    for (Particle& particle : restoredSwarm) {
+        reader.getVector(particle.position);
+        reader.getVector(particle.bestPosition);
+        reader.getVector(particle.velocity);
+        reader.get(particle.fitness);
+        reader.get(particle.bestFitness);
+        sizesOk = sizesOk && particle.position.size() == numJobs && particle.bestPosition.size() == numJobs;
+    }
+    Particle restoredBest;
+    reader.getVector(restoredBest.bestPosition);
+    reader.get(restoredBest.bestFitness);
+
+    RandomStream restoredRng;
+    reader.getRng(restoredRng);
+    vector<GenerationStats> restoredHistory;
+    reader.getVector(restoredHistory);
+
+    if (!reader.ok() || !sizesOk || restoredBest.bestPosition.size() != numJobs) {
+        console() << "AVISO: Checkpoint incompleto, iniciando do zero" << endl;
+        return false;
+    }
+
+    initializeWorkers();
+    rng = restoredRng;
+
+    swarm.swap(restoredSwarm);
+    globalBest = restoredBest;
+    generationHistory.swap(restoredHistory);
+    firstGeneration = nextGeneration;
+    resumedTime = elapsedTime;
+
+    // O relógio continua de onde parou
+    startTime = chrono::high_resolution_clock::now() -
+                chrono::duration_cast<chrono::high_resolution_clock::duration>(chrono::duration<double>(elapsedTime));
+    return true;
+}
+
+void PSO::run(const string& instanceFile, const string& outputFile) {
+    // Ler instância
+    if (!loadInstance(instanceFile)) {
+        return;
+    }
+
+    bool checkpointing = !checkpointFile.empty() && checkpointInterval > 0.0;
+    firstGeneration = 0;
+    resumedTime = 0.0;
+    if (checkpointing && resume && loadCheckpoint()) {
+        console() << "Retomado do checkpoint: geracao " << firstGeneration << ", " << resumedTime
+             << "s, best=" << globalBest.bestFitness << endl;
+    } else {
+        initialize();
+    }
+
+    if (checkpointing) {
+        checkpointWriter.reset(new CheckpointWriter(checkpointFile));
+        lastCheckpointTime = resumedTime;
+    }
+
+    console() << "Executando PSO..." << endl;
+    console() << fixed << setprecision(2);
+
+    // Loop principal
+    int gen = firstGeneration;
+    for (; gen < numGenerations && !timeUp(); gen++) {
+        iterate(gen);
+
+        if (checkpointWriter) {
+            double elapsed = chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count();
+            if (elapsed - lastCheckpointTime >= checkpointInterval) {
+                saveCheckpoint(gen + 1, elapsed, false);
+            }
+        }
+    }
+    if (gen < numGenerations) {
+        console() << "Tempo maximo atingido na geracao " << gen << endl;
+    }
+
+    if (checkpointWriter) {
+        // Checkpoint final: retomar uma instância concluída não executa mais gerações
+        double elapsed = chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count();
+        saveCheckpoint(gen, elapsed, true);
+        console() << "Checkpoints gravados: " << checkpointWriter->written()
+             << " (descartados com o disco ocupado: " << checkpointWriter->skipped() << ")" << endl;
+        checkpointWriter.reset();
+    }
+
+    saveHistory(outputFile);
+
+    console() << "\nResultados salvos em: " << outputFile << endl;
+    console() << "Melhor solução encontrada: " << globalBest.bestFitness << endl;
+}
@@ -2,10 +2,15 @@
 #define SCHEDULING_PSO_H
 
 #include "ModeloProblema.h"
-#include <random>
 #include <cmath>
 #include <algorithm>
 #include <chrono>
+#include <memory>
+#include "thread_pool.h"
+#include "operator_bandit.h"
+#include "checkpoint.h"
+#include "console.h"
+#include "random_stream.h"
 
 using namespace std;
 
@@ -32,67 +37,167 @@ struct GenerationStats {
     double elapsedTime;
 };
 
+// Topologia de vizinhança usada no aprendizado social (Step 5.3)
+enum class NeighborhoodTopology {
+    GLOBAL,     // gbest: todas as partículas aprendem com o globalBest
+    RING,       // lbest: vizinhos p - 1 e p + 1
+    VON_NEUMANN // lbest: vizinhos acima, abaixo, à esquerda e à direita numa grade toroidal
+};
+
+// Id de crossover/mutação que liga a seleção adaptativa (crossovers OC, PMX e PTL; mutações 1..4)
+constexpr int ADAPTIVE_OPERATOR = 5;
+
+// Contexto de uma thread de atualização: RNG e cópia dos dados do problema
+// usada pelo decodificador (que altera máquinas e jobs durante a simulação)
+struct SwarmWorker {
+    RandomStream rng;
+    ProblemData problemData;
+
+    // Buffers reutilizados para que os operadores não aloquem memória no laço
+    vector<int> candidate;
+    vector<int> offspring;
+    vector<int> ilsBuffer;
+    vector<char> used;
+
+    // Seleção adaptativa: operadores sorteados para a partícula atual e créditos da geração
+    int crossoverArm;
+    int mutationArm;
+    OperatorUsage crossoverUsage;
+    OperatorUsage mutationUsage;
+
+    SwarmWorker() : crossoverArm(0), mutationArm(0) {}
+
+    double uniform() { return rng.uniform01(); }
+
+    // Marcadores de jobs já usados (IDs 1..n), zerados
+    vector<char> &markUsed(int n) {
+        used.assign(n + 1, 0);
+        return used;
+    }
+};
+
 // ===== CLASSE PSO =====
 class PSO {
 private:
     // Parâmetros do PSO
     int populationSize; // P_s (tamanho da população)
     int numGenerations; // Número máximo de gerações
+    double maxSeconds; // Limite de tempo da execução (<= 0: só as gerações)
     double c1; // Coeficiente de aprendizado (local best)
     double c2; // Coeficiente de aprendizado (global best)
     double inertiaWeight; // Peso de inércia
     double mutationProb; // Probabilidade de mutação
-    int crossoverType; // Tipo de crossover (1=OP, 2=TP, 3=PMX, 4=PTL)
-    int mutationOperator; // Tipo de mutação (1=Swap, 2=Insert, 3=MultiSwap, 4=MultiInsert)
+    int crossoverType; // Tipo de crossover (1=OP, 2=TP, 3=PMX, 4=PTL, 5=adaptativo)
+    int mutationOperator; // Tipo de mutação (1=Swap, 2=Insert, 3=MultiSwap, 4=MultiInsert, 5=adaptativo)
 
     // Dados
     ProblemData problemData;
     vector<Particle> swarm;
     Particle globalBest;
     vector<GenerationStats> generationHistory;
-
-    // RNG
-    mt19937 rng;
-    uniform_real_distribution<double> uniformDist;
+    chrono::high_resolution_clock::time_point startTime;
+    bool verbose; // Imprimir progresso no console
+
+    // Vizinhança e paralelismo
+    NeighborhoodTopology neighborhood;
+    int numThreads;
+    vector<SwarmWorker> workers; // workers[0] é usado na execução sequencial
+    RandomStream rng; // Fluxo principal: chaves dos workers e de cada geração lbest
+    unique_ptr<ThreadPool> threadPool;
+    const atomic<int> *threadLimit; // Teto de threads do pool (setThreadLimit)
+    vector<vector<int>> neighborhoodBest; // Snapshot do melhor vizinho de cada partícula
+
+    // Seleção adaptativa de operadores (id ADAPTIVE_OPERATOR)
+    OperatorBandit crossoverBandit;
+    OperatorBandit mutationBandit;
+
+    // Checkpoints do run(): o laço monta o estado no buffer do writer, que grava em segundo plano
+    string checkpointFile; // Vazio: sem checkpoints
+    double checkpointInterval; // Segundos entre checkpoints periódicos
+    bool resume;
+    unique_ptr<CheckpointWriter> checkpointWriter;
+    double lastCheckpointTime;
+    int firstGeneration; // Primeira geração do run(); > 0 quando retomado
+    double resumedTime;  // Tempo já gasto antes da retomada, em segundos
 
     // Métodos auxiliares
     void initializeSwarm();
 
-    double evaluateParticle(vector<int> &position);
+    void initializeWorkers();
+
+    // nextGeneration é a geração em que a retomada continua
+    void saveCheckpoint(int nextGeneration, double elapsedTime, bool wait);
+
+    bool loadCheckpoint();
 
-    void resetProblemData();
+    double evaluateParticle(vector<int> &position, SwarmWorker &worker);
 
     void copyProblemData(ProblemData &source, ProblemData &dest);
 
     // Operadores de crossover
-    vector<int> orderCrossover(const vector<int> &parent1, const vector<int> &parent2);
+    void orderCrossover(const vector<int> &parent1, const vector<int> &parent2, vector<int> &offspring,
+                        SwarmWorker &worker);
 
-    vector<int> twoPointCrossover(const vector<int> &parent1, const vector<int> &parent2);
+    void twoPointCrossover(const vector<int> &parent1, const vector<int> &parent2, vector<int> &offspring,
+                           SwarmWorker &worker);
 
-    vector<int> pmxCrossover(const vector<int> &parent1, const vector<int> &parent2);
+    void pmxCrossover(const vector<int> &parent1, const vector<int> &parent2, vector<int> &offspring,
+                      SwarmWorker &worker);
 
-    vector<int> ptlCrossover(const vector<int> &parent1, const vector<int> &parent2);
+    void ptlCrossover(const vector<int> &parent1, const vector<int> &parent2, vector<int> &offspring,
+                      SwarmWorker &worker);
 
     // Operadores de mutação
-    void swapMutation(vector<int> &solution);
+    void swapMutation(vector<int> &solution, SwarmWorker &worker);
 
-    void insertMutation(vector<int> &solution);
+    void insertMutation(vector<int> &solution, SwarmWorker &worker);
 
-    void multiSwapMutation(vector<int> &solution);
+    void multiSwapMutation(vector<int> &solution, SwarmWorker &worker);
 
-    void multiInsertMutation(vector<int> &solution);
+    void multiInsertMutation(vector<int> &solution, SwarmWorker &worker);
 
     // ILS - Iterated Local Search
-    void ilsLocalSearch(vector<int> &solution);
+    void ilsLocalSearch(vector<int> &solution, SwarmWorker &worker);
 
-    // Operadores de aprendizado
-    void learnFromHistoryMutation(vector<int> &position);
+    // Operadores de aprendizado (instanciados por tipo de operador)
+    template <int Mutation>
+    void learnFromHistoryMutation(vector<int> &position, SwarmWorker &worker);
 
+    template <int Crossover>
+    void applyCrossover(const vector<int> &position, const vector<int> &guide, vector<int> &offspring,
+                        SwarmWorker &worker);
+
+    template <int Crossover>
     void learnFromLocalBestCrossover(const vector<int> &position, const vector<int> &localBest,
-                                     vector<int> &newPosition);
+                                     vector<int> &newPosition, SwarmWorker &worker);
 
+    template <int Crossover>
     void learnFromGlobalBestCrossover(const vector<int> &position, const vector<int> &globalBest,
-                                      vector<int> &newPosition);
+                                      vector<int> &newPosition, SwarmWorker &worker);
+
+    // Atualização de uma partícula; escreve apenas em swarm[p]
+    template <int Crossover, int Mutation>
+    void updateParticle(int p, const vector<int> &socialBest, int gen, SwarmWorker &worker);
+
+    void updateGlobalBest(int p);
+
+    // Soma os créditos das threads e atualiza os bandits ao fim da geração
+    void creditOperators(int gen);
+
+    // Laço de uma geração para um par fixo de operadores, escolhido uma vez em selectOperators
+    using IterateFn = void (PSO::*)(int);
+    IterateFn iterateFn;
+
+    template <int Crossover, int Mutation>
+    void iterateWith(int gen);
+
+    template <int Crossover>
+    static IterateFn selectIterate(int mutation);
+
+    void selectOperators();
+
+    // Copia, para cada partícula, a melhor posição pessoal da sua vizinhança (geração anterior)
+    void snapshotNeighborhoodBest();
 
 public:
     PSO(int popSize, int numGen, double c1_val, double c2_val, double inertia,
@@ -103,15 +208,59 @@ public:
     // Executar o algoritmo
     void run(const string &instanceFile, const string &outputFile);
 
+    // Etapas do run(), usadas também pelo modelo de ilhas e pelo portfólio do GA (que passa o
+    // --duedate dele)
+    bool loadInstance(const string &instanceFile, int defaultDueDate = 100);
+
+    void initialize();
+
+    void iterate(int gen);
+
+    void saveHistory(const string &outputFile) const;
+
+    // Log por geração dos operadores adaptativos; não escreve nada se nenhum for adaptativo
+    void saveOperatorLog(const string &outputFile) const;
+
+    // Migração: imigrante substitui a pior partícula do enxame
+    void acceptMigrant(const vector<int> &position, double fitness);
+
+    // Imigrante de outro processo: é reavaliado aqui antes de entrar (tamanho errado é ignorado)
+    void acceptRemoteMigrant(vector<int> &position);
+
     // Setters
     void setPopulationSize(int size) { populationSize = size; }
     void setNumGenerations(int gen) { numGenerations = gen; }
+    void setTimeLimit(double seconds) { maxSeconds = seconds; }
     void setC1(double val) { c1 = val; }
     void setC2(double val) { c2 = val; }
+    void setVerbose(bool val) { verbose = val; }
+    void setNeighborhood(NeighborhoodTopology topology) { neighborhood = topology; }
+    void setNumThreads(int threads) { numThreads = max(1, threads); }
+
+    // Teto de threads lido a cada laço paralelo; o pool continua com numThreads contextos
+    void setThreadLimit(const atomic<int> *limit) { threadLimit = limit; }
+
+    // Fluxo principal (--seed), antes de run/initialize; sem chamar, a semente vem do random_device
+    void setRandomStream(const RandomStream &stream) { rng = stream; }
+
+    // Checkpoint periódico do run() em file; com resumeRun, continua dele se for compatível
+    void setCheckpoint(const string &file, double intervalSeconds, bool resumeRun) {
+        checkpointFile = file;
+        checkpointInterval = intervalSeconds;
+        resume = resumeRun;
+    }
 
     // Getters
     const Particle &getGlobalBest() const { return globalBest; }
     const vector<GenerationStats> &getHistory() const { return generationHistory; }
+    int getNumGenerations() const { return numGenerations; }
+
+    // Limite de tempo esgotado (conta o tempo de sessões anteriores ao checkpoint)
+    bool timeUp() const {
+        return maxSeconds > 0.0 &&
+               chrono::duration<double>(chrono::high_resolution_clock::now() - startTime).count() >= maxSeconds;
+    }
+    double getResumedTime() const { return resumedTime; }
     // Método para obter o vetor bestPosition do global best
 
     // Método conveniente para retornar como string
@@ -126,5 +275,9 @@ public:
     }
 };
 
+string neighborhoodTopologyToString(NeighborhoodTopology topology);
+
+// Escreve o histórico de gerações no CSV padrão (Generation,BestFitness,...)
+void saveGenerationHistory(const vector<GenerationStats> &history, const string &outputFile);
 
 #endif // SCHEDULING_PSO_H
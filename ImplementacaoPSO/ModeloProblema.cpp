@@ -191,6 +191,23 @@ struct CompareEvent {
     }
 };
 
+void resetProblemData(ProblemData& data) {
+    // Limpar máquinas
+    for (auto& machine : data.machines) {
+        machine.second.buffer.clear();
+        machine.second.availableTime = 0.0;
+        machine.second.isBusy = 0;
+        machine.second.currentJob = nullptr;
+    }
+
+    // Limpar jobs
+    for (auto& job : data.jobs) {
+        job.priority = 0.0;
+        job.tardiness = 0.0;
+        fill(job.completionTimes.begin(), job.completionTimes.end(), 0.0);
+    }
+}
+
 // Função principal de decodificação (Algoritmo 1)
 double decodeChromosome(const vector<int>& chromosome, ProblemData& data) {
     priority_queue<Event, vector<Event>, CompareEvent> eventList;
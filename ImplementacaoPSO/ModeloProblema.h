@@ -100,4 +100,7 @@ pair<Job*, double> Machine_seize(Machine* machine, double systemClock);
 Job* Machine_release(Machine* machine, double systemClock);
 double decodeChromosome(const vector<int>& chromosome, ProblemData& data);
 
+// Limpa o estado deixado pela simulação (buffers, máquinas e tempos) para reutilizar os dados
+void resetProblemData(ProblemData& data);
+
 #endif // SCHEDULING_GA_H
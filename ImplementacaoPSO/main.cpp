@@ -1,4 +1,15 @@
 #include "AlgoritmoPSO/scheduling_pso.h"
+#include "AlgoritmoPSO/island_pso.h"
+#include "AlgoritmoPSO/random_key_pso.h"
+#include "parallel_tempering.h"
+#include "batch_runner.h"
+#include "task_runtime.h"
+#include "replication_stats.h"
+#include "random_stream.h"
+#include "batch_budget.h"
+#include "benchmark_manifest.h"
+#include "results_store.h"
+#include "migration_link.h"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -10,6 +21,7 @@
 #include <fstream>
 #include <cmath>
 #include <numeric>
+#include <thread>
 
 namespace fs = std::filesystem;
 using namespace std;
@@ -50,6 +62,9 @@ struct InstanceResult {
     // Solução
     string bestPosition;
     string psoConfig;
+
+    // Execução independente da instância (1..R com --replications R)
+    int replication;
 };
 
 // Calcular métricas expandidas
@@ -117,6 +132,34 @@ void calculateExpandedMetrics(InstanceResult& result,
         : 0.0;
 }
 
+// Linha do summary_PSO_*.csv; é também o que o armazém de resultados guarda de cada execução
+string formatSummaryRow(const InstanceResult& result) {
+    stringstream row;
+    row << result.instanceName << ","
+        << result.nJobs << ","
+        << result.nStages << ","
+        << fixed << setprecision(4)
+        << result.initialFitness << ","
+        << result.bestFitness << ","
+        << result.worstFitness << ","
+        << result.avgFitness << ","
+        << result.stdDev << ","
+        << result.finalFitness << ","
+        << result.improvement << ","
+        << result.rpd << ","
+        << result.executionTimeMs << ","
+        << result.timePerGenMs << ","
+        << result.populationSize << ","
+        << result.generations << ","
+        << result.convergenceGen << ","
+        << result.convergencePercent << ","
+        << result.fitnessDiversity << ","
+        << result.bestPosition << ","
+        << result.psoConfig << ","
+        << result.replication;
+    return row.str();
+}
+
 int main(int argc, char* argv[]) {
     cout << "============================================================" << endl;
     cout << "  PSO - PROCESSAMENTO EM LOTE (BATCH)" << endl;
@@ -133,6 +176,57 @@ int main(int argc, char* argv[]) {
     int crossoverType = 4;        // PTL
     int mutationOperator = 4;     // Multiple Insert
 
+    // Motor: "discrete" (crossover/mutação), "randomkey" (velocidade contínua sobre chaves) ou
+    // "tempering" (parallel tempering com o mesmo decodificador, uma rodada por geração)
+    string engine = "discrete";
+    TemperingParameters temperingParams;
+    bool c1Set = false, c2Set = false, inertiaSet = false;
+
+    // Modelo de ilhas (1 = enxame único)
+    int numIslands = 1;
+    int migrationInterval = 10;
+    MigrationTopology migrationTopology = MigrationTopology::RING;
+
+    // Ilhas em outros processos: este escuta em islandListen e envia os elites para islandPeers
+    string islandListen;
+    vector<string> islandPeers;
+
+    // Vizinhança do aprendizado social e threads por enxame
+    NeighborhoodTopology neighborhood = NeighborhoodTopology::GLOBAL;
+    int numThreads = 1;
+
+    // Instâncias resolvidas ao mesmo tempo (cada uma ainda usa --threads threads)
+    int numJobs = 1;
+    bool jobsSet = false;
+
+    // Execuções independentes por instância; sem --jobs, as replicações rodam em paralelo
+    int replications = 1;
+
+    // Threads do runtime de tarefas (0 = núcleos da máquina), configuradas uma vez para todo o
+    // processo: --jobs e --threads limitam o paralelismo, mas não criam threads
+    int numWorkers = 0;
+    bool pinThreads = false;
+
+    // Semente base: cada replicação usa o seu fluxo (replicationStream); sem --seed é sorteada e
+    // impressa, para que a execução possa ser repetida
+    uint64_t seed = 0;
+    bool seedSet = false;
+
+    // Tempo de parede do lote inteiro (0 = sem limite de tempo, só as gerações)
+    double batchBudget = 0.0;
+
+    // Execuções já gravadas no armazém de resultados são puladas, a menos que --recompute
+    bool recompute = false;
+
+    // Lote pelo manifesto: qualquer filtro (ou --manifest) troca a varredura do diretório pela
+    // lista do benchmark_index.txt
+    string manifestPath;
+    ManifestFilter manifestFilter;
+
+    // Checkpoints do enxame único, um por instância em outputDir
+    double checkpointInterval = 30.0;
+    bool resume = false;
+
     // Diretórios
     string instancesDir = "./Instancias";
     string outputDir = "./Resultados";
@@ -154,9 +248,11 @@ int main(int argc, char* argv[]) {
         }
         else if (arg == "--c1" && i + 1 < argc) {
             c1 = stod(argv[++i]);
+            c1Set = true;
         }
         else if (arg == "--c2" && i + 1 < argc) {
             c2 = stod(argv[++i]);
+            c2Set = true;
         }
         else if (arg == "--mutation" && i + 1 < argc) {
             mutationProb = stod(argv[++i]);
@@ -167,6 +263,89 @@ int main(int argc, char* argv[]) {
         else if (arg == "--mutoperator" && i + 1 < argc) {
             mutationOperator = stoi(argv[++i]);
         }
+        else if (arg == "--inertia" && i + 1 < argc) {
+            inertiaWeight = stod(argv[++i]);
+            inertiaSet = true;
+        }
+        else if (arg == "--engine" && i + 1 < argc) {
+            engine = argv[++i];
+        }
+        else if (arg == "--replicas" && i + 1 < argc) {
+            temperingParams.numReplicas = max(2, stoi(argv[++i]));
+        }
+        else if (arg == "--islands" && i + 1 < argc) {
+            numIslands = stoi(argv[++i]);
+        }
+        else if (arg == "--migration-interval" && i + 1 < argc) {
+            migrationInterval = stoi(argv[++i]);
+        }
+        else if (arg == "--migration-topology" && i + 1 < argc) {
+            string value = argv[++i];
+            if (value == "ring") migrationTopology = MigrationTopology::RING;
+            else if (value == "full") migrationTopology = MigrationTopology::FULL;
+        }
+        else if (arg == "--island-listen" && i + 1 < argc) {
+            islandListen = argv[++i];
+        }
+        else if (arg == "--island-peers" && i + 1 < argc) {
+            islandPeers = parseAddressList(argv[++i]);
+        }
+        else if (arg == "--neighborhood" && i + 1 < argc) {
+            string value = argv[++i];
+            if (value == "global") neighborhood = NeighborhoodTopology::GLOBAL;
+            else if (value == "ring") neighborhood = NeighborhoodTopology::RING;
+            else if (value == "vonneumann") neighborhood = NeighborhoodTopology::VON_NEUMANN;
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            numThreads = stoi(argv[++i]);
+        }
+        else if (arg == "--jobs" && i + 1 < argc) {
+            numJobs = max(1, stoi(argv[++i]));
+            jobsSet = true;
+        }
+        else if (arg == "--replications" && i + 1 < argc) {
+            replications = max(1, stoi(argv[++i]));
+        }
+        else if (arg == "--workers" && i + 1 < argc) {
+            numWorkers = stoi(argv[++i]);
+        }
+        else if (arg == "--pin-threads") {
+            pinThreads = true;
+        }
+        else if (arg == "--manifest" && i + 1 < argc) {
+            manifestPath = argv[++i];
+        }
+        else if (arg == "--class" && i + 1 < argc) {
+            manifestFilter.classes = parseClassList(argv[++i]);
+        }
+        else if (arg == "--min-jobs" && i + 1 < argc) {
+            manifestFilter.minJobs = stoi(argv[++i]);
+        }
+        else if (arg == "--max-jobs" && i + 1 < argc) {
+            manifestFilter.maxJobs = stoi(argv[++i]);
+        }
+        else if (arg == "--shard" && i + 1 < argc) {
+            if (!parseShard(argv[++i], manifestFilter.shardIndex, manifestFilter.shardCount)) {
+                cerr << "ERRO: --shard espera k/N com 1 <= k <= N" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--budget" && i + 1 < argc) {
+            batchBudget = stod(argv[++i]);
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            seed = stoull(argv[++i]);
+            seedSet = true;
+        }
+        else if (arg == "--checkpoint-interval" && i + 1 < argc) {
+            checkpointInterval = stod(argv[++i]);
+        }
+        else if (arg == "--resume") {
+            resume = true;
+        }
+        else if (arg == "--recompute") {
+            recompute = true;
+        }
         else if (arg == "--help" || arg == "-h") {
             cout << "USO: " << argv[0] << " [opcoes]" << endl;
             cout << "\nOPCOES:" << endl;
@@ -177,99 +356,359 @@ int main(int argc, char* argv[]) {
             cout << "  --c1 <valor>          Coef. local best (padrao: 0.2)" << endl;
             cout << "  --c2 <valor>          Coef. global best (padrao: 0.2)" << endl;
             cout << "  --mutation <valor>    Prob. mutacao (padrao: 0.9)" << endl;
-            cout << "  --crossover <tipo>    1=OC, 2=TP, 3=PMX, 4=PTL (padrao: 4)" << endl;
-            cout << "  --mutoperator <tipo>  1=Swap, 2=Insert, 3=MS, 4=MI (padrao: 4)" << endl;
+            cout << "  --crossover <tipo>    1=OC, 2=TP, 3=PMX, 4=PTL, 5=adaptativo (padrao: 4)" << endl;
+            cout << "  --mutoperator <tipo>  1=Swap, 2=Insert, 3=MS, 4=MI, 5=adaptativo (padrao: 4)" << endl;
+            cout << "  --engine <tipo>       discrete | randomkey | tempering (padrao: discrete)" << endl;
+            cout << "  --replicas <n>        Replicas do parallel tempering (padrao: 8)" << endl;
+            cout << "  --inertia <valor>     Peso de inercia do randomkey (padrao: 0.729)" << endl;
+            cout << "  --islands <n>         Sub-enxames em threads; divide a populacao (padrao: 1)" << endl;
+            cout << "  --migration-interval <n>  Geracoes entre migracoes (padrao: 10)" << endl;
+            cout << "  --migration-topology <t>  ring | full (padrao: ring)" << endl;
+            cout << "  --island-listen <end>     Endereco deste processo para ilhas remotas: unix:<caminho> ou tcp:<host>:<porta>" << endl;
+            cout << "  --island-peers <lista>    Enderecos (separados por virgula) que recebem os elites deste processo" << endl;
+            cout << "  --neighborhood <t>    global | ring | vonneumann (padrao: global)" << endl;
+            cout << "  --threads <n>         Threads por enxame; requer vizinhanca local (padrao: 1)" << endl;
+            cout << "  --jobs <n>            Instancias resolvidas em paralelo (padrao: 1, ou as replicacoes)" << endl;
+            cout << "  --replications <r>    Execucoes independentes por instancia, com resumo entre elas (padrao: 1)" << endl;
+            cout << "  --workers <n>         Threads do runtime compartilhado por instancias e lacos (padrao: nucleos)" << endl;
+            cout << "  --pin-threads         Fixa cada thread do runtime em um nucleo" << endl;
+            cout << "  --manifest <arquivo>  Manifesto do lote (padrao: benchmark_index.txt ao lado de --instances)" << endl;
+            cout << "  --class <lista>       Classes de tamanho do manifesto, ex.: S,M (padrao: todas)" << endl;
+            cout << "  --min-jobs <n>        Apenas instancias com pelo menos n jobs" << endl;
+            cout << "  --max-jobs <n>        Apenas instancias com no maximo n jobs" << endl;
+            cout << "  --shard <k/N>         Fatia k de N do lote filtrado, para dividir entre processos" << endl;
+            cout << "  --budget <segundos>   Tempo total do lote, dividido pelo tamanho das instancias (padrao: sem limite)" << endl;
+            cout << "  --seed <s>            Semente base; fixa o resultado do enxame unico (padrao: aleatoria)" << endl;
+            cout << "  --checkpoint-interval <s>  Segundos entre checkpoints do enxame (padrao: 30, 0 = desligado)" << endl;
+            cout << "  --resume              Continua cada instancia do seu checkpoint em <output>" << endl;
+            cout << "  --recompute           Refaz execucoes ja presentes em <output>/results_PSO.store" << endl;
             cout << "\nEXEMPLO:" << endl;
             cout << "  " << argv[0] << " --instances ./Instancias --output ./Resultados" << endl;
             return 0;
         }
     }
 
+    // Constantes clássicas de constrição para o PSO contínuo, se não informadas
+    if (engine == "randomkey") {
+        if (!c1Set) c1 = 1.49445;
+        if (!c2Set) c2 = 1.49445;
+        if (!inertiaSet) inertiaWeight = 0.729;
+    }
+
+    // Processos vizinhos trocam elites da mesma instância: uma execução por vez
+    MigrationLink remoteLink;
+    if (!islandListen.empty()) {
+        if (engine != "discrete") {
+            cerr << "ERRO: --island-listen requer o motor discrete" << endl;
+            return 1;
+        }
+        if (!remoteLink.start(islandListen, islandPeers)) {
+            return 1;
+        }
+        numJobs = 1;
+        jobsSet = true;
+    }
+
+    TaskRuntime::configure(numWorkers, pinThreads);
+    int runtimeThreads = TaskRuntime::instance().size();
+    if (!jobsSet && replications > 1) {
+        numJobs = min(replications, runtimeThreads);
+    }
+
+    // Armazém de resultados do diretório de saída; sem --seed, um lote interrompido retoma com a
+    // semente da última execução gravada com a mesma configuração
+    fs::create_directories(outputDir);
+    ResultsStore store((fs::path(outputDir) / "results_PSO.store").string());
+    string algorithm = (engine == "tempering") ? "PT" : (engine == "randomkey") ? "RKPSO" : "PSO";
+
+    // Descrição canônica de tudo que muda o resultado (sem semente, threads nem diretórios)
+    stringstream configKey;
+    configKey << setprecision(17) << "engine=" << engine << ";generations=" << numGenerations
+              << ";budget=" << batchBudget;
+    if (engine == "tempering") {
+        configKey << ";replicas=" << temperingParams.numReplicas << ";tmin=" << temperingParams.minTemperature
+                  << ";tmax=" << temperingParams.maxTemperature << ";sweeps=" << temperingParams.sweepsPerRound;
+    } else {
+        configKey << ";pop=" << populationSize << ";c1=" << c1 << ";c2=" << c2 << ";w=" << inertiaWeight;
+        if (engine != "randomkey") {
+            configKey << ";pm=" << mutationProb << ";crossover=" << crossoverType << ";mutop=" << mutationOperator
+                      << ";nbh=" << neighborhoodTopologyToString(neighborhood) << ";islands=" << numIslands;
+            if (numIslands > 1 || remoteLink.isRunning()) {
+                configKey << ";migint=" << migrationInterval << ";topo="
+                          << migrationTopologyToString(migrationTopology);
+            }
+            if (remoteLink.isRunning()) configKey << ";remote=" << islandPeers.size();
+        }
+    }
+    uint64_t configHash = hashConfig(configKey.str());
+    bool seedFromStore = !seedSet && store.latestSeed(algorithm, configHash, seed);
+    if (!seedSet && !seedFromStore) seed = randomSeed();
+
     // Mostrar configuração
     cout << "CONFIGURACAO:" << endl;
     cout << "  Instancias:   " << instancesDir << endl;
     cout << "  Resultados:   " << outputDir << endl;
     cout << "  Populacao:    " << populationSize << endl;
     cout << "  Geracoes:     " << numGenerations << endl;
+    cout << "  Semente:      " << seed << (seedSet ? "" : seedFromStore ? " (do armazem)" : " (aleatoria)") << endl;
+    cout << "  Armazem:      " << store.getPath() << " (" << store.size() << " resultados";
+    if (store.discardedLines() > 0) {
+        cout << ", " << store.discardedLines() << " linhas corrompidas ignoradas";
+    }
+    cout << ")" << endl;
+    if (batchBudget > 0.0) {
+        cout << "  Orcamento:    " << batchBudget << " s para o lote (proporcional ao tamanho)" << endl;
+    }
     cout << "  c1:           " << c1 << endl;
     cout << "  c2:           " << c2 << endl;
     cout << "  Mutacao prob: " << mutationProb << endl;
     cout << "  Crossover:    " << crossoverType;
     if (crossoverType == 4) cout << " (PTL)";
+    if (crossoverType == ADAPTIVE_OPERATOR) cout << " (adaptativo)";
     cout << endl;
     cout << "  Mutacao op:   " << mutationOperator;
     if (mutationOperator == 4) cout << " (MultiInsert)";
+    if (mutationOperator == ADAPTIVE_OPERATOR) cout << " (adaptativo)";
+    cout << endl;
+    cout << "  Motor:        " << engine << endl;
+    if (engine == "randomkey") {
+        cout << "  Inercia:      " << inertiaWeight << endl;
+    }
+    if (engine == "tempering") {
+        cout << "  Replicas:     " << temperingParams.numReplicas << " (T=" << temperingParams.minTemperature
+             << ".." << temperingParams.maxTemperature << ")" << endl;
+    }
+    cout << "  Vizinhanca:   " << neighborhoodTopologyToString(neighborhood);
+    if (neighborhood != NeighborhoodTopology::GLOBAL) cout << " (" << numThreads << " threads)";
     cout << endl;
+    if (numIslands > 1) {
+        cout << "  Ilhas:        " << numIslands << " (migracao a cada " << migrationInterval
+             << " geracoes, " << migrationTopologyToString(migrationTopology) << ")" << endl;
+    }
+    if (remoteLink.isRunning()) {
+        cout << "  Ilhas remotas: escuta em " << islandListen << ", envia para " << islandPeers.size()
+             << " processo(s)" << endl;
+    }
+    if (numJobs > 1) {
+        cout << "  Jobs:         " << numJobs << " instancias em paralelo" << endl;
+    }
+    if (replications > 1) {
+        cout << "  Replicacoes:  " << replications << endl;
+    }
+    if (numJobs > 1 || numThreads > 1 || numWorkers > 0) {
+        cout << "  Workers:      " << runtimeThreads << (pinThreads ? " (fixos em nucleos)" : "") << endl;
+    }
     cout << "============================================================" << endl << endl;
 
-    // Criar diretório de saída
-    fs::create_directories(outputDir);
-
-    // Listar todos os arquivos I*.txt
+    // Listar as instâncias: pelo manifesto (com filtros e --shard) ou todos os arquivos I*.txt
     vector<string> instanceFiles;
-    try {
-        for (const auto& entry : fs::directory_iterator(instancesDir)) {
-            if (entry.is_regular_file()) {
-                string filename = entry.path().filename().string();
-                if (filename[0] == 'I' && entry.path().extension() == ".txt") {
-                    instanceFiles.push_back(filename);
+    bool useManifest = !manifestPath.empty() || manifestFilter.active();
+    if (manifestPath.empty()) manifestPath = defaultManifestPath(instancesDir);
+
+    if (useManifest) {
+        vector<ManifestEntry> entries = readManifest(manifestPath);
+        if (entries.empty()) {
+            cerr << "ERRO: Manifesto vazio ou nao encontrado: " << manifestPath << endl;
+            return 1;
+        }
+        for (const ManifestEntry& entry : selectEntries(entries, manifestFilter)) {
+            if (!fs::exists(fs::path(instancesDir) / entry.instanceFile)) {
+                cout << "AVISO: " << entry.instanceFile << " esta no manifesto mas nao em " << instancesDir << endl;
+                continue;
+            }
+            instanceFiles.push_back(entry.instanceFile);
+        }
+        cout << "Manifesto: " << manifestPath << " (" << instanceFiles.size() << " de " << entries.size()
+             << " instancias";
+        if (manifestFilter.shardCount > 1) {
+            cout << ", shard " << manifestFilter.shardIndex << "/" << manifestFilter.shardCount;
+        }
+        cout << ")" << endl;
+    } else {
+        try {
+            for (const auto& entry : fs::directory_iterator(instancesDir)) {
+                if (entry.is_regular_file()) {
+                    string filename = entry.path().filename().string();
+                    if (filename[0] == 'I' && entry.path().extension() == ".txt") {
+                        instanceFiles.push_back(filename);
+                    }
                 }
             }
+        } catch (const exception& e) {
+            cerr << "ERRO ao ler diretorio de instancias: " << e.what() << endl;
+            return 1;
         }
-    } catch (const exception& e) {
-        cerr << "ERRO ao ler diretorio de instancias: " << e.what() << endl;
-        return 1;
-    }
 
-    if (instanceFiles.empty()) {
-        cerr << "ERRO: Nenhum arquivo I*.txt encontrado em " << instancesDir << endl;
-        return 1;
-    }
+        if (instanceFiles.empty()) {
+            cerr << "ERRO: Nenhum arquivo I*.txt encontrado em " << instancesDir << endl;
+            return 1;
+        }
 
-    // Ordenar por número (I1, I2, ..., I10, ...)
-    sort(instanceFiles.begin(), instanceFiles.end(), [](const string& a, const string& b) {
-        int numA = stoi(a.substr(1, a.find('.') - 1));
-        int numB = stoi(b.substr(1, b.find('.') - 1));
-        return numA < numB;
-    });
+        // Ordenar por número (I1, I2, ..., I10, ...)
+        sort(instanceFiles.begin(), instanceFiles.end(), [](const string& a, const string& b) {
+            int numA = stoi(a.substr(1, a.find('.') - 1));
+            int numB = stoi(b.substr(1, b.find('.') - 1));
+            return numA < numB;
+        });
+    }
 
     cout << "Encontradas " << instanceFiles.size() << " instancias para processar." << endl;
     cout << "============================================================" << endl << endl;
 
-    // Processar cada instância
-    vector<InstanceResult> results;
-    int processed = 0;
+    // Parâmetros comuns a todas as instâncias, fixados antes do lote
+    temperingParams.numThreads = numThreads;
+    temperingParams.maxRounds = numGenerations;
+
+    // Uma tarefa por execução (instância x replicação), até numJobs ao mesmo tempo; cada uma
+    // escreve só na sua posição
     int total = instanceFiles.size();
+    int numRuns = total * replications;
+    vector<InstanceResult> instanceResults(numRuns);
+    vector<char> solved(numRuns, 0);
+
+    // Chave de cada execução no armazém; só as ausentes (ou todas, com --recompute) entram no lote
+    vector<ResultKey> runKeys(numRuns);
+    vector<int> pendingRuns;
+    for (int i = 0; i < numRuns; i++) {
+        runKeys[i] = {algorithm, instanceFiles[i / replications], configHash, seed, i % replications + 1};
+        if (recompute || !store.find(runKeys[i])) pendingRuns.push_back(i);
+    }
+    if ((int) pendingRuns.size() < numRuns) {
+        cout << "Ja no armazem: " << numRuns - (int) pendingRuns.size() << " de " << numRuns
+             << " execucoes (puladas)" << endl << endl;
+    }
+
+    // Com --budget, as execuções começam da maior instância para a menor e cada uma recebe sua
+    // fatia do tempo restante ao começar; as gerações continuam sendo o limite superior
+    unique_ptr<BudgetScheduler> budget;
+    if (batchBudget > 0.0) {
+        vector<double> fileWeights = instanceWeights(manifestPath, instancesDir, instanceFiles);
+        vector<double> runWeights;
+        for (int index : pendingRuns) {
+            runWeights.push_back(fileWeights[index / replications]);
+        }
+        budget = make_unique<BudgetScheduler>(batchBudget, numJobs, runWeights);
+    }
 
-    for (const auto& instanceFile : instanceFiles) {
-        processed++;
+    runBatch((int) pendingRuns.size(), numJobs, [&](int slot) {
+        int pending = budget ? budget->order()[slot] : slot;
+        int index = pendingRuns[pending];
+        double timeLimit = budget ? budget->acquire(pending) : 0.0;
+
+        const string& instanceFile = instanceFiles[index / replications];
+        int processed = index / replications + 1;
+        int replication = index % replications + 1;
+
+        // Arquivos por execução ganham o sufixo _r<k> quando há replicações
+        string runSuffix = (replications > 1) ? "_r" + to_string(replication) : "";
 
         string instancePath = instancesDir + "/" + instanceFile;
         string instanceName = instanceFile.substr(0, instanceFile.find('.'));
-        string outputFile = outputDir + "/generations_" + instanceName + ".csv";
+        string outputFile = outputDir + "/generations_" + instanceName + runSuffix + ".csv";
 
-        cout << "[" << processed << "/" << total << "] Processando " << instanceFile << endl;
-        cout << "-------------------------------------------------------------" << endl;
+        console() << "[" << processed << "/" << total << "] Processando " << instanceFile;
+        if (replications > 1) {
+            console() << " (replicacao " << replication << "/" << replications << ")";
+        }
+        console() << endl;
+        if (budget) {
+            console() << "Fatia do orcamento: " << timeLimit << " s" << endl;
+        }
+        console() << "-------------------------------------------------------------" << endl;
+
+        // Orçamento do lote esgotado: os solvers leem tempo 0 como "sem limite", então a execução
+        // fica para a próxima sessão (o armazém a mantém pendente)
+        if (budget && timeLimit <= 0.0) {
+            console() << "AVISO: Orcamento do lote esgotado, execucao pulada" << endl;
+            budget->release(pending, 0.0);
+            return;
+        }
 
-        // Criar PSO
-        PSO pso(populationSize, numGenerations, c1, c2, inertiaWeight,
-                mutationProb, crossoverType, mutationOperator);
+        // Fluxo da execução: depende só da semente e da replicação, não da ordem do lote
+        RandomStream stream = replicationStream(seed, replication - 1);
 
         // Medir tempo
         auto startTime = high_resolution_clock::now();
 
-        // Executar PSO
-        pso.run(instancePath, outputFile);
+        // Executar PSO (enxame único ou modelo de ilhas)
+        vector<GenerationStats> history;
+        string bestPosition;
+        double resumedSeconds = 0.0; // Tempo de sessões anteriores, vindo do checkpoint
+        if (engine == "tempering") {
+            ProblemData problem;
+            if (!readInstanceFromFile(instancePath, problem)) {
+                cerr << "Erro ao ler instância" << endl;
+                if (budget) budget->release(pending, 0.0);
+                return;
+            }
+            TemperingParameters runParams = temperingParams;
+            runParams.maxSeconds = timeLimit;
+            ParallelTempering<ProblemData> tempering(runParams, problem);
+            tempering.setRandomStream(stream);
+            vector<int> best = tempering.run(vector<int>());
+            for (const TemperingStats &stats : tempering.getHistory()) {
+                history.push_back({stats.round, stats.bestFitness, stats.avgFitness, stats.worstFitness,
+                                   stats.elapsedTime});
+            }
+            saveGenerationHistory(history, outputFile);
+
+            // Mesmo formato das posições do PSO: sequência 1-based separada por "-"
+            for (size_t i = 0; i < best.size(); i++) {
+                if (i > 0) bestPosition += "-";
+                bestPosition += to_string(best[i] + 1);
+            }
+        } else if (engine == "randomkey") {
+            RandomKeyPSO rkPso(populationSize, numGenerations, inertiaWeight, c1, c2);
+            rkPso.setNumThreads(numThreads);
+            rkPso.setRandomStream(stream);
+            rkPso.setTimeLimit(timeLimit);
+            rkPso.run(instancePath, outputFile);
+            history = rkPso.getHistory();
+            bestPosition = rkPso.getGlobalBestPositionString();
+        } else if (numIslands > 1 || remoteLink.isRunning()) {
+            IslandPSO islandPso(numIslands, migrationInterval, migrationTopology,
+                                populationSize, numGenerations, c1, c2, inertiaWeight,
+                                mutationProb, crossoverType, mutationOperator);
+            islandPso.setNeighborhood(neighborhood);
+            islandPso.setRandomStream(stream);
+            islandPso.setTimeLimit(timeLimit);
+            if (remoteLink.isRunning()) {
+                // Só os processos na mesma instância e replicação trocam elites com esta execução
+                remoteLink.beginRun(migrationTag(instanceFile, replication));
+                islandPso.setMigrationLink(&remoteLink);
+            }
+            islandPso.run(instancePath, outputFile);
+            if (remoteLink.isRunning()) {
+                console() << "Ilhas remotas: " << remoteLink.framesSent() << " elites enviados, "
+                          << remoteLink.framesReceived() << " recebidos (total do processo)" << endl;
+            }
+            history = islandPso.getHistory();
+            bestPosition = islandPso.getGlobalBestPositionString();
+        } else {
+            PSO pso(populationSize, numGenerations, c1, c2, inertiaWeight,
+                    mutationProb, crossoverType, mutationOperator);
+            pso.setNeighborhood(neighborhood);
+            pso.setNumThreads(numThreads);
+            pso.setRandomStream(stream);
+            pso.setTimeLimit(timeLimit);
+            pso.setCheckpoint(outputDir + "/checkpoint_" + instanceName + runSuffix + ".bin", checkpointInterval, resume);
+            pso.run(instancePath, outputFile);
+            resumedSeconds = pso.getResumedTime();
+            pso.saveOperatorLog(outputDir + "/operators_" + instanceName + runSuffix + ".csv");
+            history = pso.getHistory();
+            bestPosition = pso.getGlobalBestPositionString();
+        }
 
         auto endTime = high_resolution_clock::now();
-        auto duration = duration_cast<milliseconds>(endTime - startTime);
 
-        // Obter histórico
-        const auto& history = pso.getHistory();
+        // O que sobrou da fatia (ex.: terminou as gerações antes) volta para as próximas execuções
+        if (budget) budget->release(pending, std::chrono::duration<double>(endTime - startTime).count());
+        auto duration = duration_cast<milliseconds>(endTime - startTime) +
+                        duration_cast<milliseconds>(std::chrono::duration<double>(resumedSeconds));
 
         if (history.empty()) {
-            cout << "AVISO: Nenhum historico gerado!" << endl;
-            continue;
+            console() << "AVISO: Nenhum historico gerado!" << endl;
+            return;
         }
 
         // Ler dados da instância
@@ -288,31 +727,73 @@ int main(int argc, char* argv[]) {
         result.initialFitness = history[0].bestFitness;
         result.finalFitness = history.back().bestFitness;
 
-        // Obter melhor posição (assumindo que PSO.h tem método getGlobalBest())
-        // Se não tiver, usar placeholder
-        result.bestPosition = pso.getGlobalBestPositionString();
+        result.bestPosition = bestPosition;
+        result.replication = replication;
 
-        result.psoConfig = "PSO|Pop:" + to_string(populationSize) + "|Gen:" +
+        string enginePrefix = (engine == "randomkey") ? "RKPSO|W:" + to_string(inertiaWeight) : "PSO";
+        result.psoConfig = enginePrefix + "|Pop:" + to_string(populationSize) + "|Gen:" +
                           to_string(numGenerations) + "|c1:" + to_string(c1) +
                           "|c2:" + to_string(c2) + "|Pm:" + to_string(mutationProb) +
                           "|Cross:" + to_string(crossoverType) + "|Mut:" + to_string(mutationOperator);
+        if (engine == "tempering") {
+            result.psoConfig = "PT|R:" + to_string(temperingParams.numReplicas) + "|Gen:" +
+                               to_string(numGenerations) + "|T:" + to_string(temperingParams.minTemperature) +
+                               "-" + to_string(temperingParams.maxTemperature);
+        } else if (neighborhood != NeighborhoodTopology::GLOBAL) {
+            result.psoConfig += "|Nbh:" + neighborhoodTopologyToString(neighborhood);
+        }
+        if (engine != "tempering" && numIslands > 1) {
+            result.psoConfig += "|Islands:" + to_string(numIslands) + "|MigInt:" +
+                                to_string(migrationInterval) + "|Topo:" +
+                                migrationTopologyToString(migrationTopology);
+        }
+        if (remoteLink.isRunning()) {
+            result.psoConfig += "|Peers:" + to_string(islandPeers.size());
+        }
+        result.psoConfig += "|Seed:" + to_string(seed);
 
         // Calcular métricas expandidas
         calculateExpandedMetrics(result, history, duration.count(),
-                                populationSize, numGenerations);
-
-        results.push_back(result);
+                                (engine == "tempering") ? temperingParams.numReplicas : populationSize,
+                                numGenerations);
+
+        instanceResults[index] = result;
+        solved[index] = 1;
+
+        // Gravado assim que termina: uma interrupção depois daqui não perde esta execução
+        StoredResult stored;
+        stored.key = runKeys[index];
+        stored.jobs = nJobs;
+        stored.stages = nStages;
+        stored.config = result.psoConfig;
+        stored.summaryRow = formatSummaryRow(result);
+        stored.run = {result.finalFitness, result.executionTimeMs, bestFitnessCurve(history)};
+        if (!store.append(stored)) {
+            console() << "AVISO: Falha ao gravar no armazem de resultados" << endl;
+        }
 
         // Mostrar resultado
-        cout << "  Jobs x Stages:   " << nJobs << " x " << nStages << endl;
-        cout << "  Fitness inicial: " << fixed << setprecision(2) << result.initialFitness << endl;
-        cout << "  Fitness final:   " << result.finalFitness << endl;
-        cout << "  Melhoria:        " << result.improvement << "%" << endl;
-        cout << "  StdDev:          " << result.stdDev << endl;
-        cout << "  Convergencia:    " << result.convergenceGen << " geracoes ("
+        console() << "  Jobs x Stages:   " << nJobs << " x " << nStages << endl;
+        console() << "  Fitness inicial: " << fixed << setprecision(2) << result.initialFitness << endl;
+        console() << "  Fitness final:   " << result.finalFitness << endl;
+        console() << "  Melhoria:        " << result.improvement << "%" << endl;
+        console() << "  StdDev:          " << result.stdDev << endl;
+        console() << "  Convergencia:    " << result.convergenceGen << " geracoes ("
              << result.convergencePercent << "%)" << endl;
-        cout << "  Tempo:           " << result.executionTimeMs << " ms" << endl;
-        cout << "-------------------------------------------------------------" << endl << endl;
+        console() << "  Tempo:           " << result.executionTimeMs << " ms" << endl;
+        console() << "-------------------------------------------------------------" << endl << endl;
+    });
+
+    // Execuções desta sessão, para as estatísticas do console
+    vector<InstanceResult> results;
+    for (int i = 0; i < numRuns; i++) {
+        if (solved[i]) results.push_back(instanceResults[i]);
+    }
+
+    // Os resumos cobrem o lote inteiro (inclusive execuções de sessões anteriores), lidos do armazém
+    vector<const StoredResult*> records(numRuns);
+    for (int i = 0; i < numRuns; i++) {
+        records[i] = store.find(runKeys[i]);
     }
 
     // Salvar resumo geral
@@ -320,7 +801,7 @@ int main(int argc, char* argv[]) {
     auto timestamp = system_clock::to_time_t(now);
 
     stringstream summaryFilename;
-    summaryFilename << outputDir << "/summary_PSO_" << timestamp << ".csv";
+    summaryFilename << outputDir << "/summary_PSO_" << timestamp << shardTag(manifestFilter) << ".csv";
 
     ofstream summaryFile(summaryFilename.str());
     if (summaryFile.is_open()) {
@@ -328,42 +809,61 @@ int main(int argc, char* argv[]) {
         summaryFile << "Instance,Jobs,Stages,InitialFitness,BestFitness,WorstFitness,"
                    << "AvgFitness,StdDev,FinalFitness,Improvement(%),RPD(%),"
                    << "ExecutionTime_ms,TimePerGen_ms,PopSize,Generations,ConvergenceGen,"
-                   << "ConvergencePercent(%),FitnessDiversity,BestChromosome,PSOConfig\n";
-
-        // Dados
-        for (const auto& result : results) {
-            summaryFile << result.instanceName << ","
-                       << result.nJobs << ","
-                       << result.nStages << ","
-                       << fixed << setprecision(4)
-                       << result.initialFitness << ","
-                       << result.bestFitness << ","
-                       << result.worstFitness << ","
-                       << result.avgFitness << ","
-                       << result.stdDev << ","
-                       << result.finalFitness << ","
-                       << result.improvement << ","
-                       << result.rpd << ","
-                       << result.executionTimeMs << ","
-                       << result.timePerGenMs << ","
-                       << result.populationSize << ","
-                       << result.generations << ","
-                       << result.convergenceGen << ","
-                       << result.convergencePercent << ","
-                       << result.fitnessDiversity << ","
-                       << result.bestPosition << ","
-                       << result.psoConfig << "\n";
+                   << "ConvergencePercent(%),FitnessDiversity,BestChromosome,PSOConfig,Replication\n";
+
+        // Dados, na ordem das instâncias
+        for (const StoredResult* record : records) {
+            if (record) summaryFile << record->summaryRow << "\n";
         }
 
         summaryFile.close();
         cout << "Resumo salvo em: " << summaryFilename.str() << endl;
     }
 
+    // Estatísticas entre as replicações de cada instância (posições consecutivas em records)
+    if (replications > 1) {
+        string replicationFilename = outputDir + "/replications_PSO_" + to_string(timestamp) +
+                                     shardTag(manifestFilter) + ".csv";
+        ofstream replicationFile(replicationFilename);
+        if (replicationFile.is_open()) {
+            writeReplicationHeader(replicationFile);
+
+            cout << "\nReplicacoes por instancia (" << replications << " execucoes):" << endl;
+            for (int first = 0; first < numRuns; first += replications) {
+                vector<ReplicationRun> instanceRuns;
+                const StoredResult* reference = nullptr;
+                for (int r = 0; r < replications; r++) {
+                    if (!records[first + r]) continue;
+                    instanceRuns.push_back(records[first + r]->run);
+                    reference = records[first + r];
+                }
+                if (!reference) continue;
+
+                ReplicationSummary summary = summarizeReplications(instanceRuns);
+                string instanceName = reference->key.instance.substr(0, reference->key.instance.find('.'));
+                writeReplicationRow(replicationFile, instanceName, reference->jobs, reference->stages, summary,
+                                    reference->config);
+
+                cout << "  " << instanceName << ": Best=" << fixed << setprecision(2)
+                     << summary.bestFitness << " Media=" << summary.meanFitness
+                     << " Mediana=" << summary.medianFitness << " Desvio=" << summary.stdDev
+                     << " | Ate a media: " << summary.timeToMeanMs << " ms ("
+                     << summary.runsReachingMean << "/" << summary.runs << ")" << endl;
+            }
+
+            replicationFile.close();
+            cout << "Resumo das replicacoes salvo em: " << replicationFilename << endl;
+        }
+    }
+
     // Estatísticas finais
     cout << "\n============================================================" << endl;
     cout << "PROCESSAMENTO CONCLUIDO" << endl;
     cout << "============================================================" << endl;
     cout << "Total de instancias: " << results.size() << endl;
+    if ((int) pendingRuns.size() < numRuns) {
+        cout << "Reaproveitadas do armazem: " << numRuns - (int) pendingRuns.size() << endl;
+    }
 
     if (!results.empty()) {
         double avgImprovement = 0.0;
@@ -393,6 +893,9 @@ int main(int argc, char* argv[]) {
     cout << "\nArquivos gerados:" << endl;
     cout << "  - generations_<instance>.csv  (um por instancia)" << endl;
     cout << "  - summary_PSO_<timestamp>.csv (resumo geral EXPANDIDO)" << endl;
+    if (replications > 1) {
+        cout << "  - replications_PSO_<timestamp>.csv (estatisticas entre as replicacoes)" << endl;
+    }
     cout << "\nDiretorio: " << outputDir << endl;
     cout << "============================================================" << endl;
 
@@ -0,0 +1,101 @@
+# ============================================================================
+# JUNÇÃO DOS RESUMOS POR SHARD (--shard k/N)
+# ============================================================================
+# Cada processo de um benchmark dividido com --shard k/N grava o seu próprio
+# summary_<GA|PSO>_<timestamp>_shard<k>of<N>.csv (e replications_..., com
+# --replications). Este script junta os arquivos de um mesmo tipo num único
+# CSV, no mesmo formato, ordenado por instância e replicação.
+#
+# Uso:
+#   python merge_shards.py -o summary_GA_completo.csv Resultados/summary_GA_*_shard*.csv
+#   python merge_shards.py -o replications_PSO_completo.csv host1/replications_PSO_* host2/replications_PSO_*
+
+import argparse
+import csv
+import glob
+import os
+import re
+import sys
+
+SHARD_PATTERN = re.compile(r"_shard(\d+)of(\d+)")
+
+
+def instance_number(name: str) -> int:
+    digits = re.sub(r"\D", "", name)
+    return int(digits) if digits else 0
+
+
+def check_shards(files):
+    # Avisa se faltam shards de 1..N ou se os arquivos vêm de divisões diferentes
+    shards = {}
+    for path in files:
+        match = SHARD_PATTERN.search(os.path.basename(path))
+        if match:
+            shards.setdefault(int(match.group(2)), set()).add(int(match.group(1)))
+
+    if len(shards) > 1:
+        print(f"AVISO: arquivos de divisoes diferentes: {sorted(shards)} shards")
+    for count, present in shards.items():
+        missing = sorted(set(range(1, count + 1)) - present)
+        if missing:
+            print(f"AVISO: faltam os shards {missing} de {count}")
+
+
+def merge(files, output):
+    header = None
+    rows = {}
+    for path in files:
+        with open(path, newline='', encoding='utf-8', errors='replace') as f:
+            reader = csv.reader(f)
+            file_header = next(reader, None)
+            if file_header is None:
+                continue
+            if header is None:
+                header = file_header
+            elif file_header != header:
+                sys.exit(f"ERRO: {path} tem colunas diferentes dos demais arquivos")
+
+            replication_col = header.index("Replication") if "Replication" in header else None
+            for row in reader:
+                if not row:
+                    continue
+                key = (row[0], row[replication_col] if replication_col is not None else "")
+                if key in rows:
+                    print(f"AVISO: {key[0]} (replicacao {key[1] or 1}) repetida; mantida a de {path}")
+                rows[key] = row
+
+    if header is None:
+        sys.exit("ERRO: nenhum arquivo com cabecalho")
+
+    ordered = sorted(rows.items(), key=lambda item: (instance_number(item[0][0]), int(item[0][1] or 1)))
+    with open(output, 'w', newline='', encoding='utf-8') as f:
+        writer = csv.writer(f)
+        writer.writerow(header)
+        for _, row in ordered:
+            writer.writerow(row)
+
+    print(f"{len(ordered)} linhas de {len(files)} arquivo(s) salvas em: {output}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Junta os resumos CSV gravados por cada --shard k/N")
+    parser.add_argument("inputs", nargs="+", help="Arquivos (ou padroes glob) de um mesmo tipo de resumo")
+    parser.add_argument("-o", "--output", required=True, help="CSV de saida")
+    args = parser.parse_args()
+
+    files = []
+    for pattern in args.inputs:
+        matches = sorted(glob.glob(pattern))
+        files.extend(matches if matches else [pattern])
+    files = [f for f in dict.fromkeys(files) if os.path.abspath(f) != os.path.abspath(args.output)]
+
+    for path in files:
+        if not os.path.isfile(path):
+            sys.exit(f"ERRO: arquivo nao encontrado: {path}")
+
+    check_shards(files)
+    merge(files, args.output)
+
+
+if __name__ == "__main__":
+    main()